@@ -2,16 +2,92 @@
 #include "SSE.h"
 #include "../core/Log.h"
 #include "../core/Settings.h"
+#include "../core/Stats.h"
+#include "../core/Trajectory.h"
+#include "../core/ZoneNames.h"
 #include "../discord/DiscordLoop.h"
 #include "../windows/AutoStart.h"
 #include "../windows/BorderlessWindow.h"
 #include "../database/SessionDatabase.h"
+#include "../memory/ReadMetrics.h"
+#include "../monitoring/GameSampler.h"
 
 #include "json.hpp"
 
+#include <algorithm>
+#include <memory>
+
 using json = nlohmann::json;
 
-void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chrono::steady_clock::time_point startTime) {
+// Slot from the first capture of an /api/instances/<id>/... route, or null if out of range.
+static GameSampler* FindInstance(const httplib::Request& req) {
+    std::string id = req.matches[1].str();
+    if (id.size() > 3) {
+        return nullptr;
+    }
+
+    size_t instance = std::stoul(id);
+    return instance < MAX_INSTANCES ? &g_gameSamplers[instance] : nullptr;
+}
+
+// Row id from the first capture of a /api/<table>/<id>/... route, or null if it cannot be one.
+static std::optional<int> FindRowId(const httplib::Request& req) {
+    std::string id = req.matches[1].str();
+    if (id.size() > 9) {
+        return std::nullopt;
+    }
+    return std::stoi(id);
+}
+
+static void SendNotFound(httplib::Response& res, const char* code, const char* message) {
+    json response = {
+        {"success", false},
+        {"error", {
+            {"code", code},
+            {"message", message}
+        }}
+    };
+    res.status = httplib::StatusCode::NotFound_404;
+    res.set_content(response.dump(), "application/json");
+}
+
+static void SendInstanceNotFound(httplib::Response& res) {
+    SendNotFound(res, "INSTANCE_NOT_FOUND", "No such instance");
+}
+
+// Streams each hold a game event bus slot; once those are taken a client gets this rather
+// than a stream.
+static void SendTooManyStreams(httplib::Response& res) {
+    json response = {
+        {"success", false},
+        {"error", {
+            {"code", "TOO_MANY_STREAMS"},
+            {"message", "Too many open stats streams"}
+        }}
+    };
+    res.status = httplib::StatusCode::ServiceUnavailable_503;
+    res.set_content(response.dump(), "application/json");
+}
+
+// Starts an SSE stats stream on a bus subscription, which lives as long as the response.
+static void StartStatsStream(httplib::Response& res, size_t instance) {
+    auto events = std::make_shared<GameEventBus::Subscription>(g_gameEvents.Subscribe(instance));
+    if (!events->IsValid()) {
+        SendTooManyStreams(res);
+        return;
+    }
+
+    res.set_header("Content-Type", "text/event-stream");
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("Connection", "keep-alive");
+
+    res.set_chunked_content_provider("text/event-stream", [events](size_t, httplib::DataSink& sink) {
+        streamStats(sink, *events);
+        return false;
+    });
+}
+
+void setupRoutes(httplib::Server& server, std::chrono::steady_clock::time_point startTime) {
     server.set_post_routing_handler([](const httplib::Request& req, httplib::Response& res) {
         auto origin = req.get_header_value("Origin");
         if (origin == ALLOWED_ORIGIN) {
@@ -41,6 +117,7 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
                 {"isDiscordRpcEnabled", g_settings.isDiscordRpcEnabled.load()},
                 {"isBorderlessFullscreenEnabled", g_settings.isBorderlessFullscreenEnabled.load()},
                 {"isAutoStartEnabled", g_settings.isAutoStartEnabled.load()},
+                {"trajectorySampleRateHz", g_settings.trajectorySampleRateHz.load()},
             }}
         };
 
@@ -77,8 +154,13 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
                 enabled ? AutoStart::Enable() : AutoStart::Disable();
             }
 
+            if (body.contains("trajectorySampleRateHz")) {
+                int rate = body["trajectorySampleRateHz"];
+                g_settings.trajectorySampleRateHz = std::clamp(rate, 0, Settings::MAX_TRAJECTORY_RATE_HZ);
+            }
+
             g_settings.SaveSettings();
-            g_discordCv.notify_one();
+            wakeDiscordPresence();
 
             json response = {
                 {"success", true},
@@ -87,7 +169,8 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
                     {"isPlaytimeVisible", g_settings.isPlaytimeVisible.load()},
                     {"isDiscordRpcEnabled", g_settings.isDiscordRpcEnabled.load()},
                     {"isBorderlessFullscreenEnabled", g_settings.isBorderlessFullscreenEnabled.load()},
-                    {"isAutoStartEnabled", g_settings.isAutoStartEnabled.load()}
+                    {"isAutoStartEnabled", g_settings.isAutoStartEnabled.load()},
+                    {"trajectorySampleRateHz", g_settings.trajectorySampleRateHz.load()}
                 }}
             };
 
@@ -116,7 +199,8 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
                 {"startingDeaths", session.startingDeaths},
                 {"endingDeaths", session.endingDeaths},
                 {"sessionDeaths", session.sessionDeaths},
-                {"deathsPerHour", session.deathsPerHour}
+                {"deathsPerHour", session.deathsPerHour},
+                {"instanceId", session.instanceId}
             });
         }
 
@@ -128,6 +212,35 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
         res.set_content(response.dump(), "application/json");
     });
 
+    server.Get(R"(/api/sessions/(\d+)/trajectory)", [](const httplib::Request& req, httplib::Response& res) {
+        auto id = FindRowId(req);
+        auto session = id ? g_sessionDb.GetSession(*id) : std::nullopt;
+        if (!session) {
+            SendNotFound(res, "SESSION_NOT_FOUND", "No such session");
+            return;
+        }
+
+        json points = json::array();
+        size_t encodedBytes = 0;
+        for (const TrajectoryChunk& chunk : g_sessionDb.GetSessionTrajectory(session->instanceId, session->startTime)) {
+            encodedBytes += chunk.data.size();
+            for (const TrajectoryPoint& point : Trajectory::Decode(chunk.data)) {
+                points.push_back({point.timeMs, point.x, point.y, point.z});
+            }
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"sessionId", session->id},
+                {"encodedBytes", encodedBytes},
+                {"points", points}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
     server.Get("/api/characters", [](const httplib::Request& req, httplib::Response& res) {
         auto characters = g_sessionDb.GetAllCharacters();
         
@@ -166,7 +279,9 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
                 {"isBossDeath", death.isBossDeath},
                 {"zoneId", death.zoneId},
                 {"zoneName", death.zoneName},
-                {"timestamp", death.timestamp}
+                {"timestamp", death.timestamp},
+                {"instanceId", death.instanceId},
+                {"bossHpPercent", death.bossHpPercent ? json(*death.bossHpPercent) : json(nullptr)}
                 });
         }
 
@@ -178,6 +293,49 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
         res.set_content(response.dump(), "application/json");
     });
 
+    server.Get(R"(/api/deaths/(\d+)/position)", [](const httplib::Request& req, httplib::Response& res) {
+        auto id = FindRowId(req);
+        auto death = id ? g_sessionDb.GetDeath(*id) : std::nullopt;
+        if (!death) {
+            SendNotFound(res, "DEATH_NOT_FOUND", "No such death");
+            return;
+        }
+
+        // Points are only stored when the player moves, so the last one at or before the
+        // death is where it happened, even if it was recorded long before.
+        std::optional<TrajectoryPoint> position;
+        if (death->diedAtMs > 0) {
+            for (const TrajectoryChunk& chunk : g_sessionDb.GetTrajectoryBefore(death->instanceId, death->diedAtMs, 1)) {
+                if (chunk.characterId != death->characterId) {
+                    continue;
+                }
+                for (const TrajectoryPoint& point : Trajectory::Decode(chunk.data)) {
+                    if (point.timeMs <= death->diedAtMs) {
+                        position = point;
+                    }
+                }
+            }
+        }
+
+        if (!position) {
+            SendNotFound(res, "POSITION_NOT_RECORDED", "No trajectory was recorded before this death");
+            return;
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"deathId", death->id},
+                {"sampledAtMs", position->timeMs},
+                {"x", position->x},
+                {"y", position->y},
+                {"z", position->z}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
     server.Get("/api/deaths/stats", [](const httplib::Request& req, httplib::Response& res) {
         std::optional<int> characterId = std::nullopt;
         auto param = req.get_param_value("characterId");
@@ -249,29 +407,127 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
         res.set_content(response.dump(), "application/json");
     });
 
-    server.Get("/api/status", [&](const httplib::Request& req, httplib::Response& res) {
-        bool isRunning = statsReader.IsProcessRunning();
+    server.Get("/api/zones/time", [](const httplib::Request& req, httplib::Response& res) {
+        std::optional<int> characterId = std::nullopt;
+        auto param = req.get_param_value("characterId");
+        if (!param.empty()) {
+            characterId = std::stoi(param);
+        }
+
+        auto zoneTimes = g_sessionDb.GetZoneTimes(characterId);
 
-        if (!isRunning && statsReader.Initialize()) {
-            isRunning = true;
+        json zonesArray = json::array();
+        for (const ZoneTime& zoneTime : zoneTimes) {
+            zonesArray.push_back({
+                {"zoneId", zoneTime.zoneId},
+                {"zone", GetZoneName(zoneTime.zoneId)},
+                {"timeMs", zoneTime.timeMs},
+                {"updatedAt", zoneTime.updatedAt}
+            });
         }
 
+        json response = {
+            {"success", true},
+            {"data", zonesArray}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get("/api/status", [](const httplib::Request& req, httplib::Response& res) {
+        auto snapshot = g_gameSampler.Latest();
+
         json response = {
             {"success", true},
             {"data", {
-                {"status", isRunning ? "in_game" : "not_running"}
+                {"status", snapshot->isProcessRunning ? "in_game" : "not_running"},
+                {"gameState", gameStateToString(snapshot->gameState)}
             }}
         };
 
         res.set_content(response.dump(), "application/json");
     });
 
-    server.Get("/api/character", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!statsReader.IsInitialized()) {
-            statsReader.Initialize();
+    server.Get("/api/sampler", [](const httplib::Request& req, httplib::Response& res) {
+        SamplerMetrics metrics = g_gameSampler.GetMetrics();
+
+        json modes = json::array();
+        for (size_t mode = 0; mode < SAMPLING_MODE_COUNT; ++mode) {
+            const SamplingModeMetrics& modeMetrics = metrics.modes[mode];
+            double seconds = std::chrono::duration<double>(modeMetrics.wallTime).count();
+            double cpuMs = std::chrono::duration<double, std::milli>(modeMetrics.cpuTime).count();
+
+            json groups = json::object();
+            for (size_t group = 0; group < FIELD_GROUP_COUNT; ++group) {
+                auto interval = SamplingPolicy::GetInterval(static_cast<SamplingMode>(mode), static_cast<FieldGroup>(group));
+                groups[SamplingPolicy::ToString(static_cast<FieldGroup>(group))] = {
+                    {"targetHz", 1000.0 / interval.count()},
+                    {"effectiveHz", seconds > 0 ? modeMetrics.groupSamples[group] / seconds : 0.0}
+                };
+            }
+
+            modes.push_back({
+                {"mode", SamplingPolicy::ToString(static_cast<SamplingMode>(mode))},
+                {"seconds", seconds},
+                {"ticks", modeMetrics.ticks},
+                {"cpuMs", cpuMs},
+                {"cpuPercent", seconds > 0 ? cpuMs / (seconds * 10.0) : 0.0},
+                {"groups", groups}
+            });
         }
 
-        if (!statsReader.IsProcessRunning()) {
+        json response = {
+            {"success", true},
+            {"data", {
+                {"mode", SamplingPolicy::ToString(metrics.currentMode)},
+                {"modes", modes}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get("/api/debug/memory", [](const httplib::Request& req, httplib::Response& res) {
+        json reads = json::array();
+        for (const ReadMetricSummary& summary : GetReadMetrics().Collect()) {
+            if (summary.calls == 0) {
+                continue;
+            }
+
+            json histogram = json::object();
+            for (size_t bucket = 0; bucket < ReadMetricSummary::BUCKETS; ++bucket) {
+                if (summary.histogram[bucket] > 0) {
+                    histogram[std::to_string(uint64_t{1} << bucket)] = summary.histogram[bucket];
+                }
+            }
+
+            reads.push_back({
+                {"name", summary.name},
+                {"calls", summary.calls},
+                {"failures", summary.failures},
+                {"failureRate", static_cast<double>(summary.failures) / summary.calls},
+                {"totalMs", summary.totalNs / 1e6},
+                {"meanUs", summary.totalNs / 1e3 / summary.calls},
+                {"p50Us", summary.PercentileNs(50.0) / 1e3},
+                {"p99Us", summary.PercentileNs(99.0) / 1e3},
+                {"histogramNs", histogram}
+            });
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"reads", reads}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get("/api/character", [](const httplib::Request& req, httplib::Response& res) {
+        auto snapshot = g_gameSampler.Latest();
+
+        if (!snapshot->isProcessRunning) {
             json response = {
                 {"success", false},
                 {"error", {
@@ -284,8 +540,7 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
             return;
         }
 
-        auto nameResult = statsReader.GetCharacterName();
-        if (!nameResult) {
+        if (!snapshot->characterName) {
             json response = {
                 {"success", false},
                 {"error", {
@@ -298,7 +553,7 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
             return;
         }
 
-        std::wstring wname = *nameResult;
+        const std::wstring& wname = *snapshot->characterName;
         std::string name(wname.begin(), wname.end());
 
         json response = {
@@ -311,26 +566,15 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
         res.set_content(response.dump(), "application/json");
     });
 
-    server.Get("/api/stats", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!statsReader.IsInitialized()) {
-            statsReader.Initialize();
-        }
-
-        auto deathsResult = statsReader.GetDeathCount();
-        auto playTimeResult = statsReader.GetPlayTime();
-
-        if (!deathsResult || !playTimeResult) {
-            statsReader.Initialize();
-            deathsResult = statsReader.GetDeathCount();
-            playTimeResult = statsReader.GetPlayTime();
-        }
+    server.Get("/api/stats", [](const httplib::Request& req, httplib::Response& res) {
+        auto snapshot = g_gameSampler.Latest();
 
-        if (deathsResult && playTimeResult && *playTimeResult > 0) {
+        if (snapshot->deaths && snapshot->playtime && *snapshot->playtime > 0) {
             json response = {
                 {"success", true},
                 {"data", {
-                    {"deaths", *deathsResult},
-                    {"playtime", *playTimeResult}
+                    {"deaths", *snapshot->deaths},
+                    {"playtime", *snapshot->playtime}
                 }}
             };
             res.set_content(response.dump(), "application/json");
@@ -361,15 +605,180 @@ void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chro
         res.set_content(response.dump(), "application/json");
     });
 
+    server.Get("/api/watches", [](const httplib::Request& req, httplib::Response& res) {
+        auto snapshot = g_gameSampler.Latest();
+
+        json watches = json::array();
+        if (snapshot->watches) {
+            for (size_t i = 0; i < snapshot->watches->size(); ++i) {
+                const WatchEntry& entry = (*snapshot->watches)[i];
+
+                json value = nullptr;
+                if (i < snapshot->watchValues.size() && snapshot->watchValues[i]) {
+                    std::visit([&](auto raw) { value = raw; }, *snapshot->watchValues[i]);
+                }
+
+                watches.push_back({
+                    {"name", entry.name},
+                    {"type", watchTypeToString(entry.type)},
+                    {"rateHz", entry.rateHz},
+                    {"value", value}
+                });
+            }
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"watches", watches}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get("/api/flags/events", [](const httplib::Request& req, httplib::Response& res) {
+        uint64_t since = 0;
+        auto param = req.get_param_value("since");
+        if (!param.empty()) {
+            since = std::stoull(param);
+        }
+
+        json events = json::array();
+        for (const EventFlagEvent& event : g_gameSampler.GetFlagEvents(since)) {
+            events.push_back({
+                {"id", event.id},
+                {"flag", event.flag},
+                {"set", event.set},
+                {"timestamp", Stats::FormatTimestampMs(event.sampledAt)}
+            });
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"events", events}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get("/api/inventory/ledger", [](const httplib::Request& req, httplib::Response& res) {
+        std::optional<int> characterId = std::nullopt;
+        auto param = req.get_param_value("characterId");
+        if (!param.empty()) {
+            characterId = std::stoi(param);
+        }
+
+        int64_t since = 0;
+        param = req.get_param_value("since");
+        if (!param.empty()) {
+            since = std::stoll(param);
+        }
+
+        int limit = 500;
+        param = req.get_param_value("limit");
+        if (!param.empty()) {
+            limit = std::clamp(std::stoi(param), 1, 5000);
+        }
+
+        json entries = json::array();
+        for (const InventoryLedgerEntry& entry : g_sessionDb.GetInventoryLedger(characterId, since, limit)) {
+            entries.push_back({
+                {"id", entry.id},
+                {"characterId", entry.characterId},
+                {"instanceId", entry.instanceId},
+                {"kind", entry.kind},
+                {"itemId", entry.itemId},
+                {"slot", entry.slot},
+                {"delta", entry.delta},
+                {"quantity", entry.quantity},
+                {"baseline", entry.isBaseline},
+                {"timestamp", Stats::FormatTimestampMs(std::chrono::system_clock::time_point(std::chrono::milliseconds(entry.changedAtMs)))}
+            });
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"entries", entries}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
     server.Get("/api/stats/stream", [](const httplib::Request& req, httplib::Response& res) {
-        res.set_header("Content-Type", "text/event-stream");
-        res.set_header("Cache-Control", "no-cache");
-        res.set_header("Connection", "keep-alive");
-
-        res.set_chunked_content_provider("text/event-stream", [](size_t, httplib::DataSink& sink) {
-            DS3StatsReader statsReader;
-            streamStats(statsReader, sink);
-            return false;
-        });
+        StartStatsStream(res, 0);
+    });
+
+    server.Get("/api/instances", [](const httplib::Request& req, httplib::Response& res) {
+        json instances = json::array();
+        for (size_t instance = 0; instance < MAX_INSTANCES; ++instance) {
+            const GameSampler& sampler = g_gameSamplers[instance];
+            auto processId = sampler.GetTargetProcess();
+            if (processId == 0) {
+                continue;
+            }
+
+            auto snapshot = sampler.Latest();
+            instances.push_back({
+                {"id", instance},
+                {"processId", processId},
+                {"status", snapshot->isProcessRunning ? "in_game" : "not_running"},
+                {"mode", SamplingPolicy::ToString(snapshot->mode)},
+                {"gameState", gameStateToString(snapshot->gameState)},
+                {"buildTimestamp", snapshot->buildTimestamp ? json(*snapshot->buildTimestamp) : json(nullptr)}
+            });
+        }
+
+        json response = {
+            {"success", true},
+            {"data", instances}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get(R"(/api/instances/(\d+)/stats)", [](const httplib::Request& req, httplib::Response& res) {
+        GameSampler* sampler = FindInstance(req);
+        if (!sampler) {
+            SendInstanceNotFound(res);
+            return;
+        }
+
+        auto snapshot = sampler->Latest();
+        if (!snapshot->isProcessRunning || !snapshot->deaths || !snapshot->playtime) {
+            json response = {
+                {"success", false},
+                {"error", {
+                    {"code", "GAME_NOT_RUNNING"},
+                    {"message", "Game is not running"}
+                }}
+            };
+            res.status = httplib::StatusCode::ServiceUnavailable_503;
+            res.set_content(response.dump(), "application/json");
+            return;
+        }
+
+        json response = {
+            {"success", true},
+            {"data", {
+                {"deaths", *snapshot->deaths},
+                {"playtime", *snapshot->playtime}
+            }}
+        };
+
+        res.set_content(response.dump(), "application/json");
+    });
+
+    server.Get(R"(/api/instances/(\d+)/stats/stream)", [](const httplib::Request& req, httplib::Response& res) {
+        GameSampler* sampler = FindInstance(req);
+        if (!sampler) {
+            SendInstanceNotFound(res);
+            return;
+        }
+        StartStatsStream(res, static_cast<size_t>(sampler - g_gameSamplers.data()));
     });
 }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "httplib.h"
-#include "../memory/DS3StatsReader.h"
 
 #include <chrono>
 
@@ -9,4 +8,4 @@ constexpr const char* APP_VERSION = "1.0.0";
 constexpr const char* ALLOWED_ORIGIN = "http://localhost:5173";
 constexpr int SERVER_PORT = 3000;
 
-void setupRoutes(httplib::Server& server, DS3StatsReader& statsReader, std::chrono::steady_clock::time_point startTime);
+void setupRoutes(httplib::Server& server, std::chrono::steady_clock::time_point startTime);
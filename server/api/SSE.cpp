@@ -1,14 +1,19 @@
 #include "SSE.h"
 #include "../core/Log.h"
 #include "../core/Settings.h"
+#include "../monitoring/GameEvents.h"
+#include "../monitoring/GameMonitor.h"
 
 #include "json.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <thread>
 
 using json = nlohmann::json;
 
+// Stats go to a client at most this often; game state changes and deaths go at once.
+static constexpr auto STATS_INTERVAL = std::chrono::milliseconds(1500);
+
 static bool sendEvent(httplib::DataSink& sink, const std::string& type, const json& data) {
     json event = {
         {"type", type},
@@ -18,77 +23,77 @@ static bool sendEvent(httplib::DataSink& sink, const std::string& type, const js
     return sink.write(message.c_str(), message.size());
 }
 
-void streamStats(DS3StatsReader& statsReader, httplib::DataSink& sink) {
-    uint32_t lastDeathCount = 0;
-    uint32_t lastPlayTime = 0;
-    bool wasConnected = false;
-    bool firstRun = true;
-    bool statusSent = false;
-    int reconnectDelay = 1500;
-    constexpr int maxReconnectDelay = 30000;
+static bool sendStatus(httplib::DataSink& sink, const GameStatus& status) {
+    json statusData = {{"status", status.isRunning ? "in_game" : "not_running"}};
+    return sendEvent(sink, "status", statusData);
+}
+
+static bool sendStats(httplib::DataSink& sink, const GameStatus& status) {
+    json statsData = json::object();
+    if (g_settings.isDeathCountVisible) {
+        statsData["deaths"] = status.deaths;
+    }
+    if (g_settings.isPlaytimeVisible) {
+        statsData["playtime"] = status.playtime;
+    }
+    return statsData.empty() || sendEvent(sink, "stats", statsData);
+}
 
+void streamStats(httplib::DataSink& sink, GameEventBus::Subscription& events) {
     log(LogLevel::INFO, "Client connected to SSE stream");
 
-    while (true) {
-        bool isConnected = statsReader.IsProcessRunning();
+    GameStatus status = events.Initial();
+    if (!sendStatus(sink, status) || (status.hasStats && !sendStats(sink, status))) {
+        log(LogLevel::INFO, "Client disconnected from SSE stream");
+        return;
+    }
 
-        if (!statsReader.IsInitialized()) {
-            auto initResult = statsReader.Initialize();
-            if (initResult) {
-                isConnected = true;
-            }
-        }
+    // Playtime changes on every progress sample, so StatsChanged is only noted here and the
+    // latest stats are sent once STATS_INTERVAL has passed since the last send.
+    auto nextStatsAt = std::chrono::steady_clock::now() + STATS_INTERVAL;
+    bool statsPending = false;
 
-        if (isConnected != wasConnected || !statusSent) {
-            json statusData = {{"status", isConnected ? "in_game" : "not_running"}};
-            if (!sendEvent(sink, "status", statusData)) {
-                log(LogLevel::INFO, "Client disconnected from SSE stream");
-                return;
-            }
-            statusSent = true;
+    GameEvent event;
+    while (g_running) {
+        auto now = std::chrono::steady_clock::now();
+        auto timeout = statsPending
+            ? std::chrono::ceil<std::chrono::milliseconds>(std::max(nextStatsAt - now, std::chrono::steady_clock::duration::zero()))
+            : STATS_INTERVAL;
 
-            if (isConnected && !wasConnected) {
+        bool sent = true;
+        bool statsDue = false;
+        if (events.Next(event, timeout)) {
+            ApplyGameEvent(status, event);
+
+            if (event.type == GameEventType::GameDetected) {
                 log(LogLevel::INFO, "Connected to DarkSoulsIII.exe");
-                reconnectDelay = 1500;
-            } else if (!isConnected && wasConnected) {
+                sent = sendStatus(sink, status);
+            } else if (event.type == GameEventType::GameExited) {
                 log(LogLevel::WARN, "Game disconnected, waiting...");
-                reconnectDelay = 1500;
+                sent = sendStatus(sink, status);
+                statsPending = false;
+            } else if (event.type == GameEventType::StatsChanged) {
+                statsPending = true;
+            } else if (event.type == GameEventType::Resync) {
+                status = events.Initial();
+                sent = sendStatus(sink, status);
+                statsDue = status.hasStats;
+                statsPending = false;
+            } else {
+                statsDue = true;
             }
-            wasConnected = isConnected;
-        }
-
-        if (!isConnected) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(reconnectDelay));
-            reconnectDelay = std::min(reconnectDelay * 2, maxReconnectDelay);
-            continue;
         }
 
-        auto deathsResult = statsReader.GetDeathCount();
-        auto playTimeResult = statsReader.GetPlayTime();
-
-        json statsData;
-        bool changed = false;
-
-        if (g_settings.isDeathCountVisible && deathsResult && (firstRun || *deathsResult != lastDeathCount)) {
-            lastDeathCount = *deathsResult;
-            statsData["deaths"] = lastDeathCount;
-            changed = true;
+        now = std::chrono::steady_clock::now();
+        if (statsDue || (statsPending && now >= nextStatsAt)) {
+            sent = sent && sendStats(sink, status);
+            statsPending = false;
+            nextStatsAt = now + STATS_INTERVAL;
         }
 
-        if (g_settings.isPlaytimeVisible && playTimeResult && (firstRun || *playTimeResult != lastPlayTime)) {
-            lastPlayTime = *playTimeResult;
-            statsData["playtime"] = lastPlayTime;
-            changed = true;
+        if (!sent) {
+            log(LogLevel::INFO, "Client disconnected from SSE stream");
+            return;
         }
-
-        if (changed) {
-            if (!sendEvent(sink, "stats", statsData)) {
-                log(LogLevel::INFO, "Client disconnected from SSE stream");
-                return;
-            }
-            firstRun = false;
-        }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "httplib.h"
-#include "../memory/DS3StatsReader.h"
+#include "../monitoring/GameEvents.h"
 
-void streamStats(DS3StatsReader& statsReader, httplib::DataSink& sink);
+// Sends the subscription's instance status and stats until the client goes away.
+void streamStats(httplib::DataSink& sink, GameEventBus::Subscription& events);
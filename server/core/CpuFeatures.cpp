@@ -0,0 +1,37 @@
+#include "CpuFeatures.h"
+
+#if defined(EMBER_SIMD_X64) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    bool DetectAvx2() {
+#ifndef EMBER_SIMD_X64
+        return false;
+#elif defined(_MSC_VER)
+        int info[4] = {};
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+
+        __cpuid(info, 1);
+        bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        if (!osSavesYmm) {
+            return false;
+        }
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+}
+
+namespace CpuFeatures {
+    bool HasAvx2() {
+        static const bool hasAvx2 = DetectAvx2();
+        return hasAvx2;
+    }
+}
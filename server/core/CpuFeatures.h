@@ -0,0 +1,18 @@
+#pragma once
+
+// x64 builds get SSE2 unconditionally and AVX2 behind a runtime check. Functions using
+// AVX2 intrinsics are marked EMBER_TARGET_AVX2 so GCC and Clang accept them without -mavx2.
+#if defined(_M_X64) || defined(__x86_64__)
+#define EMBER_SIMD_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define EMBER_TARGET_AVX2
+#else
+#define EMBER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace CpuFeatures {
+    // Checked once; also requires the OS to save YMM registers.
+    bool HasAvx2();
+}
@@ -0,0 +1,193 @@
+#include "Executor.h"
+
+#include <algorithm>
+
+Executor g_executor;
+
+Task::promise_type::~promise_type() {
+    if (executor) {
+        executor->liveTasks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+Task::~Task() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+Executor::~Executor() {
+    Stop();
+}
+
+void Executor::Start() {
+    thread = std::thread([this] { Run(); });
+}
+
+void Executor::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping.store(true, std::memory_order_release);
+    }
+    cv.notify_all();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void Executor::Spawn(Task task) {
+    auto handle = std::exchange(task.handle, nullptr);
+    handle.promise().executor = this;
+    liveTasks.fetch_add(1, std::memory_order_acq_rel);
+    Post(handle);
+}
+
+void Executor::Post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(handle);
+    }
+    cv.notify_one();
+}
+
+void Executor::ArmTimer(CoroutineWaiter& waiter, Clock::time_point due) {
+    if (freeTimers.empty()) {
+        freeTimers.push_back(timers.size());
+        timers.push_back(nullptr);
+    }
+    waiter.timer = freeTimers.back();
+    freeTimers.pop_back();
+
+    timers[waiter.timer] = &waiter;
+    wheel.Schedule(waiter.timer, due);
+}
+
+void Executor::ReleaseTimer(CoroutineWaiter& waiter) {
+    if (waiter.timer == SIZE_MAX) {
+        return;
+    }
+    wheel.Cancel(waiter.timer);
+    timers[waiter.timer] = nullptr;
+    freeTimers.push_back(waiter.timer);
+    waiter.timer = SIZE_MAX;
+}
+
+void Executor::Expire(CoroutineWaiter* waiter) {
+    if (waiter->signal) {
+        std::lock_guard<std::mutex> lock(waiter->signal->mutex);
+
+        // Already handed to Post by Notify; its timer is released when it resumes.
+        if (waiter->done) {
+            return;
+        }
+        waiter->done = true;
+        std::erase(waiter->signal->waiters, waiter);
+    }
+    waiter->handle.resume();
+}
+
+void Executor::ExpireAll() {
+    for (size_t id = 0; id < timers.size(); ++id) {
+        if (timers[id] && wheel.IsScheduled(id)) {
+            wheel.Cancel(id);
+            Expire(timers[id]);
+        }
+    }
+}
+
+void Executor::Run() {
+    std::vector<std::coroutine_handle<>> batch;
+
+    while (true) {
+        bool stopRequested = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto hasWork = [&] { return !ready.empty() || IsStopping(); };
+
+            auto wakeup = wheel.NextWakeup();
+            if (wakeup) {
+                cv.wait_until(lock, *wakeup, hasWork);
+            } else {
+                cv.wait(lock, hasWork);
+            }
+
+            batch.swap(ready);
+            stopRequested = IsStopping();
+        }
+
+        for (std::coroutine_handle<> handle : batch) {
+            handle.resume();
+        }
+        batch.clear();
+
+        // A resumed task may arm another timer, so each is looked up before it is expired.
+        wheel.Advance(Clock::now(), expired);
+        for (size_t id : expired) {
+            if (CoroutineWaiter* waiter = timers[id]) {
+                Expire(waiter);
+            }
+        }
+        expired.clear();
+
+        if (stopRequested) {
+            ExpireAll();
+            if (liveTasks.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+}
+
+void Executor::SleepAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    waiter.handle = handle;
+    waiter.executor = &executor;
+    executor.ArmTimer(waiter, due);
+}
+
+bool Executor::SleepAwaiter::await_resume() {
+    executor.ReleaseTimer(waiter);
+    return !executor.IsStopping();
+}
+
+AsyncSignal::Awaiter::Awaiter(AsyncSignal& signal, Executor& executor, uint64_t lastCount, Clock::time_point due)
+    : signal(signal), lastCount(lastCount), due(due) {
+    waiter.executor = &executor;
+}
+
+bool AsyncSignal::Awaiter::await_ready() const {
+    return waiter.executor->IsStopping() || signal.Count() != lastCount;
+}
+
+bool AsyncSignal::Awaiter::await_suspend(std::coroutine_handle<> handle) {
+    waiter.handle = handle;
+    waiter.signal = &signal;
+    {
+        std::lock_guard<std::mutex> lock(signal.mutex);
+        if (signal.count.load(std::memory_order_acquire) != lastCount) {
+            return false;
+        }
+        signal.waiters.push_back(&waiter);
+    }
+
+    // A Notify from now on only queues the coroutine, which cannot resume before this
+    // returns to the executor loop, so the timer is in place by then.
+    waiter.executor->ArmTimer(waiter, due);
+    return true;
+}
+
+uint64_t AsyncSignal::Awaiter::await_resume() {
+    waiter.executor->ReleaseTimer(waiter);
+    return signal.Count();
+}
+
+void AsyncSignal::Notify() {
+    std::lock_guard<std::mutex> lock(mutex);
+    count.fetch_add(1, std::memory_order_release);
+
+    for (CoroutineWaiter* waiter : waiters) {
+        waiter->done = true;
+        waiter->executor->Post(waiter->handle);
+    }
+    waiters.clear();
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "TimerWheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class AsyncSignal;
+class Executor;
+
+// A coroutine suspended on an Executor timer, and possibly on an AsyncSignal as well; it is
+// resumed by whichever fires first. Lives in the awaiter, so in the coroutine frame.
+struct CoroutineWaiter {
+    std::coroutine_handle<> handle;
+    Executor* executor = nullptr;
+    AsyncSignal* signal = nullptr;
+    bool done = false;              // resumed or about to be; under the signal's mutex
+    size_t timer = SIZE_MAX;
+};
+
+// Fire-and-forget coroutine, started by Executor::Spawn. Its frame is freed when it returns.
+class Task {
+public:
+    struct promise_type {
+        Executor* executor = nullptr;
+
+        Task get_return_object() noexcept { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        ~promise_type();
+    };
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&&) = delete;
+    ~Task();
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    friend class Executor;
+};
+
+// Runs coroutine tasks on one thread, so loops that mostly wait are written as plain loops
+// around co_await rather than each holding a thread and its stack. Sleeping tasks wait in a
+// TimerWheel. Stop is cooperative: every pending and later wait returns at once, reporting
+// the stop, and Stop returns when the last task has finished, so a task must not wait again
+// once a wait has reported it.
+class Executor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class SleepAwaiter {
+    private:
+        Executor& executor;
+        Clock::time_point due;
+        CoroutineWaiter waiter;
+
+    public:
+        SleepAwaiter(Executor& executor, Clock::time_point due) : executor(executor), due(due) {}
+
+        bool await_ready() const { return executor.IsStopping() || due <= Clock::now(); }
+        void await_suspend(std::coroutine_handle<> handle);
+
+        // False once the executor is stopping.
+        bool await_resume();
+    };
+
+private:
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::coroutine_handle<>> ready;
+    std::atomic<bool> stopping = false;
+    std::atomic<size_t> liveTasks = 0;
+
+    // Executor thread only.
+    TimerWheel wheel;
+    std::vector<CoroutineWaiter*> timers;
+    std::vector<size_t> freeTimers;
+    std::vector<size_t> expired;
+
+    void Run();
+    void Expire(CoroutineWaiter* waiter);
+    void ExpireAll();
+
+    friend class AsyncSignal;
+    friend struct Task::promise_type;
+
+public:
+    Executor() = default;
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    void Start();
+    void Stop();
+
+    void Spawn(Task task);
+
+    // Resumes the coroutine on the executor thread. Any thread.
+    void Post(std::coroutine_handle<> handle);
+
+    bool IsStopping() const { return stopping.load(std::memory_order_acquire); }
+
+    // co_await only from a task on this executor.
+    SleepAwaiter SleepUntil(Clock::time_point due) { return SleepAwaiter(*this, due); }
+    SleepAwaiter SleepFor(Clock::duration duration) { return SleepAwaiter(*this, Clock::now() + duration); }
+
+    // Executor thread only.
+    void ArmTimer(CoroutineWaiter& waiter, Clock::time_point due);
+    void ReleaseTimer(CoroutineWaiter& waiter);
+};
+
+// An increasing count that executor tasks can wait on, as a condition variable is waited on
+// by threads. Notify may be called from any thread.
+class AsyncSignal {
+public:
+    using Clock = Executor::Clock;
+
+    class Awaiter {
+    private:
+        AsyncSignal& signal;
+        uint64_t lastCount;
+        Clock::time_point due;
+        CoroutineWaiter waiter;
+
+    public:
+        Awaiter(AsyncSignal& signal, Executor& executor, uint64_t lastCount, Clock::time_point due);
+
+        bool await_ready() const;
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        // The count when resumed.
+        uint64_t await_resume();
+    };
+
+private:
+    std::mutex mutex;
+    std::atomic<uint64_t> count = 0;
+    std::vector<CoroutineWaiter*> waiters;
+
+    friend class Executor;
+
+public:
+    void Notify();
+    uint64_t Count() const { return count.load(std::memory_order_acquire); }
+
+    // Resumes once the count differs from lastCount, after timeout, or when the executor stops.
+    Awaiter Wait(Executor& executor, uint64_t lastCount, Clock::duration timeout) {
+        return Awaiter(*this, executor, lastCount, Clock::now() + timeout);
+    }
+};
+
+// Runs gameMonitorLoop and Discord presence.
+extern Executor g_executor;
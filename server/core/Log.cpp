@@ -8,7 +8,11 @@
 void log(LogLevel level, const std::string& message) {
     std::time_t now = std::time(nullptr);
     std::tm tm{};
+#ifdef _WIN32
     localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
 
     const char* levelStr = "INFO ";
     switch (level) {
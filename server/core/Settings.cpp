@@ -3,6 +3,7 @@
 
 #include "json.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 using json = nlohmann::json;
@@ -26,6 +27,7 @@ void Settings::LoadSettings() {
         isDiscordRpcEnabled = settingsData.value("isDiscordRpcEnabled", true);
         isBorderlessFullscreenEnabled = settingsData.value("isBorderlessFullscreenEnabled", false);
         isAutoStartEnabled = settingsData.value("isAutoStartEnabled", false);
+        trajectorySampleRateHz = std::clamp(settingsData.value("trajectorySampleRateHz", 10), 0, MAX_TRAJECTORY_RATE_HZ);
     }
     catch (...) {
         log(LogLevel::WARN, "Invalid settings.json, restoring defaults");
@@ -40,6 +42,7 @@ void Settings::SaveSettings() {
         {"isDiscordRpcEnabled", isDiscordRpcEnabled.load()},
         {"isBorderlessFullscreenEnabled", isBorderlessFullscreenEnabled.load()},
         {"isAutoStartEnabled", isAutoStartEnabled.load()},
+        {"trajectorySampleRateHz", trajectorySampleRateHz.load()},
     };
 
     std::ofstream settingsFile(FILENAME);
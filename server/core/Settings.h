@@ -11,6 +11,10 @@ struct Settings {
     std::atomic<bool> isBorderlessFullscreenEnabled = false;
     std::atomic<bool> isAutoStartEnabled = false;
 
+    // Player position samples per second for trajectories, 0 to stop recording them.
+    static constexpr int MAX_TRAJECTORY_RATE_HZ = 30;
+    std::atomic<int> trajectorySampleRateHz = 10;
+
     void LoadSettings();
     void SaveSettings();
 };
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Capacity must be a power of two; one slot is never used to tell full from empty.
+template<typename T, size_t Capacity>
+class SpscRing {
+private:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    static constexpr size_t MASK = Capacity - 1;
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::array<T, Capacity> slots{};
+    alignas(CACHE_LINE) std::atomic<size_t> head{0};
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};
+
+public:
+    // Producer side. Returns false and drops the value when the ring is full.
+    bool TryPush(const T& value) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        size_t nextTail = (currentTail + 1) & MASK;
+        if (nextTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        slots[currentTail] = value;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool IsEmpty() const {
+        return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+    }
+
+    bool TryPop(T& value) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = slots[currentHead];
+        head.store((currentHead + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+};
@@ -15,6 +15,18 @@ namespace Stats {
         return oss.str();
     }
 
+    std::string FormatTimestampMs(std::chrono::system_clock::time_point time) {
+        std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+        std::tm tm{};
+        localtime_s(&tm, &seconds);
+
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << milliseconds;
+        return oss.str();
+    }
+
     double CalculateDeathsPerHour(int deaths, int durationMs) {
         if (durationMs <= 0) {
             return 0.0;
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 namespace Stats {
     std::string GetCurrentTimestamp();
+    std::string FormatTimestampMs(std::chrono::system_clock::time_point time);
     double CalculateDeathsPerHour(int deaths, int durationMs);
 }
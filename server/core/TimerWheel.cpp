@@ -0,0 +1,180 @@
+#include "TimerWheel.h"
+
+#include <bit>
+
+TimerWheel::TimerWheel(Clock::time_point origin) : origin(origin) {
+    heads.fill(NONE);
+}
+
+uint64_t TimerWheel::ToTick(Clock::time_point time, bool roundUp) const {
+    if (time <= origin) {
+        return 0;
+    }
+    auto elapsed = time - origin;
+    auto ticks = roundUp ? std::chrono::ceil<std::chrono::milliseconds>(elapsed) : std::chrono::floor<std::chrono::milliseconds>(elapsed);
+    return static_cast<uint64_t>(ticks.count());
+}
+
+void TimerWheel::Link(uint32_t id, uint16_t list) {
+    Timer& timer = timers[id];
+    timer.list = list;
+    timer.prev = NONE;
+    timer.next = heads[list];
+    if (timer.next != NONE) {
+        timers[timer.next].prev = id;
+    }
+    heads[list] = id;
+
+    if (list < READY_LIST) {
+        occupied[list / SLOTS] |= uint64_t{1} << (list % SLOTS);
+    }
+}
+
+void TimerWheel::Unlink(uint32_t id) {
+    Timer& timer = timers[id];
+    if (timer.prev != NONE) {
+        timers[timer.prev].next = timer.next;
+    } else {
+        heads[timer.list] = timer.next;
+    }
+    if (timer.next != NONE) {
+        timers[timer.next].prev = timer.prev;
+    }
+
+    if (timer.list < READY_LIST && heads[timer.list] == NONE) {
+        occupied[timer.list / SLOTS] &= ~(uint64_t{1} << (timer.list % SLOTS));
+    }
+    timer.list = NO_LIST;
+}
+
+void TimerWheel::Place(uint32_t id) {
+    uint64_t due = timers[id].due;
+    if (due <= current) {
+        Link(id, READY_LIST);
+        return;
+    }
+
+    // The highest base-64 digit in which the deadline and the wheel's time differ.
+    int level = (std::bit_width(due ^ current) - 1) / LEVEL_BITS;
+    if (level >= LEVELS) {
+        Link(id, OVERFLOW_LIST);
+        return;
+    }
+
+    size_t slot = (due >> (level * LEVEL_BITS)) & (SLOTS - 1);
+    Link(id, static_cast<uint16_t>(level * SLOTS + slot));
+}
+
+void TimerWheel::TakeList(uint16_t list, std::vector<size_t>& ids) {
+    for (uint32_t id = heads[list]; id != NONE;) {
+        uint32_t next = timers[id].next;
+        timers[id].list = NO_LIST;
+        ids.push_back(id);
+        id = next;
+    }
+    heads[list] = NONE;
+
+    if (list < READY_LIST) {
+        occupied[list / SLOTS] &= ~(uint64_t{1} << (list % SLOTS));
+    }
+}
+
+void TimerWheel::Cascade(uint16_t list) {
+    uint32_t id = heads[list];
+    heads[list] = NONE;
+    if (list < READY_LIST) {
+        occupied[list / SLOTS] &= ~(uint64_t{1} << (list % SLOTS));
+    }
+
+    while (id != NONE) {
+        uint32_t next = timers[id].next;
+        Place(id);
+        id = next;
+    }
+}
+
+uint64_t TimerWheel::NextEventTick() const {
+    if (heads[READY_LIST] != NONE) {
+        return current;
+    }
+
+    // A timer at level L sits in a slot above the wheel's digit L, and any lower level's
+    // timers fall due before the wheel reaches the next of those slots.
+    for (int level = 0; level < LEVELS; ++level) {
+        int shift = level * LEVEL_BITS;
+        size_t digit = (current >> shift) & (SLOTS - 1);
+        uint64_t above = digit == SLOTS - 1 ? 0 : occupied[level] & (~uint64_t{0} << (digit + 1));
+        if (above != 0) {
+            uint64_t base = current & ~((uint64_t{1} << (shift + LEVEL_BITS)) - 1);
+            return base + (static_cast<uint64_t>(std::countr_zero(above)) << shift);
+        }
+    }
+
+    if (heads[OVERFLOW_LIST] != NONE) {
+        constexpr int SPAN_BITS = LEVELS * LEVEL_BITS;
+        return ((current >> SPAN_BITS) + 1) << SPAN_BITS;
+    }
+    return UINT64_MAX;
+}
+
+void TimerWheel::Schedule(size_t id, Clock::time_point due) {
+    if (id >= timers.size()) {
+        timers.resize(id + 1);
+    }
+    if (timers[id].list != NO_LIST) {
+        Unlink(static_cast<uint32_t>(id));
+    }
+    if (due == Clock::time_point::max()) {
+        return;
+    }
+
+    timers[id].due = ToTick(due, true);
+    Place(static_cast<uint32_t>(id));
+}
+
+void TimerWheel::Cancel(size_t id) {
+    if (IsScheduled(id)) {
+        Unlink(static_cast<uint32_t>(id));
+    }
+}
+
+bool TimerWheel::IsScheduled(size_t id) const {
+    return id < timers.size() && timers[id].list != NO_LIST;
+}
+
+void TimerWheel::Advance(Clock::time_point now, std::vector<size_t>& expired) {
+    uint64_t target = ToTick(now, false);
+
+    TakeList(READY_LIST, expired);
+
+    while (current < target) {
+        uint64_t next = NextEventTick();
+        if (next > target) {
+            current = target;
+            break;
+        }
+        current = next;
+
+        // Highest level first, so a timer moved down can be moved again in the same tick.
+        if ((current & ((uint64_t{1} << (LEVELS * LEVEL_BITS)) - 1)) == 0) {
+            Cascade(OVERFLOW_LIST);
+        }
+        for (int level = LEVELS - 1; level >= 1; --level) {
+            int shift = level * LEVEL_BITS;
+            if ((current & ((uint64_t{1} << shift) - 1)) == 0) {
+                Cascade(static_cast<uint16_t>(level * SLOTS + ((current >> shift) & (SLOTS - 1))));
+            }
+        }
+
+        TakeList(static_cast<uint16_t>(current & (SLOTS - 1)), expired);
+        TakeList(READY_LIST, expired);
+    }
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::NextWakeup() const {
+    uint64_t tick = NextEventTick();
+    if (tick == UINT64_MAX) {
+        return std::nullopt;
+    }
+    return origin + tick * TICK;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Hierarchical timing wheel over 1 ms ticks: four levels of 64 slots cover about 4.6 hours,
+// and later deadlines wait in an overflow list. Arming, moving and cancelling a timer are
+// O(1), and the next deadline is found from one occupancy bitmap per level rather than by
+// looking at every timer. A timer lives in the slot of the highest tick digit in which its
+// deadline differs from the wheel's time, and is moved down a level each time the wheel
+// reaches that digit, so it is only ever touched once per level.
+//
+// Timers are named by small dense ids chosen by the caller. A timer never fires early and
+// at most one tick late. Not thread-safe.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr auto TICK = std::chrono::milliseconds(1);
+
+private:
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr size_t SLOTS = size_t{1} << LEVEL_BITS;
+    static constexpr int LEVELS = 4;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint16_t READY_LIST = LEVELS * SLOTS;      // deadline already reached
+    static constexpr uint16_t OVERFLOW_LIST = READY_LIST + 1;   // beyond the top level
+    static constexpr uint16_t NO_LIST = UINT16_MAX;
+
+    struct Timer {
+        uint64_t due = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint16_t list = NO_LIST;
+    };
+
+    Clock::time_point origin;
+    uint64_t current = 0;       // every timer due at or before this tick has been handed out
+
+    std::vector<Timer> timers;
+    std::array<uint32_t, OVERFLOW_LIST + 1> heads;
+    std::array<uint64_t, LEVELS> occupied{};
+
+    uint64_t ToTick(Clock::time_point time, bool roundUp) const;
+    uint64_t NextEventTick() const;
+
+    void Link(uint32_t id, uint16_t list);
+    void Unlink(uint32_t id);
+    void Place(uint32_t id);
+    void TakeList(uint16_t list, std::vector<size_t>& ids);
+    void Cascade(uint16_t list);
+
+public:
+    explicit TimerWheel(Clock::time_point origin = Clock::now());
+
+    // Arms the timer, or moves it if armed. A deadline already passed fires on the next
+    // Advance; Clock::time_point::max() disarms it.
+    void Schedule(size_t id, Clock::time_point due);
+    void Cancel(size_t id);
+    bool IsScheduled(size_t id) const;
+
+    // Appends the id of every timer due by now, earliest first, and disarms them. Timers armed
+    // with a deadline the wheel had already passed come before the rest, in no set order.
+    void Advance(Clock::time_point now, std::vector<size_t>& expired);
+
+    // When Advance next has something to do: a deadline, or moving timers down a level.
+    // Never later than the earliest deadline; empty when no timer is armed.
+    std::optional<Clock::time_point> NextWakeup() const;
+};
@@ -0,0 +1,142 @@
+#include "Trajectory.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool GetVarint(std::span<const uint8_t> in, size_t& position, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= in.size()) {
+                return false;
+            }
+
+            uint8_t byte = in[position++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t ZigZag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t UnZigZag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    int32_t Quantize(float value) {
+        return static_cast<int32_t>(std::lround(value / TrajectoryEncoder::QUANTUM));
+    }
+}
+
+bool TrajectoryEncoder::Append(const TrajectoryPoint& point) {
+    const int32_t quantized[3] = {Quantize(point.x), Quantize(point.y), Quantize(point.z)};
+
+    if (count == 0) {
+        PutVarint(data, static_cast<uint64_t>(point.timeMs));
+        for (int axis = 0; axis < 3; ++axis) {
+            PutVarint(data, ZigZag(quantized[axis]));
+            last[axis] = quantized[axis];
+            lastStep[axis] = 0;
+        }
+
+        firstMs = point.timeMs;
+        lastMs = point.timeMs;
+        ++count;
+        return true;
+    }
+
+    if (quantized[0] == last[0] && quantized[1] == last[1] && quantized[2] == last[2]) {
+        return false;
+    }
+
+    PutVarint(data, static_cast<uint64_t>(std::max<int64_t>(point.timeMs - lastMs, 0)));
+    for (int axis = 0; axis < 3; ++axis) {
+        int32_t step = quantized[axis] - last[axis];
+        PutVarint(data, ZigZag(static_cast<int64_t>(step) - lastStep[axis]));
+        last[axis] = quantized[axis];
+        lastStep[axis] = step;
+    }
+
+    lastMs = std::max(point.timeMs, lastMs);
+    ++count;
+    return true;
+}
+
+std::span<const uint8_t> TrajectoryEncoder::GetData() const {
+    return data;
+}
+
+size_t TrajectoryEncoder::GetCount() const {
+    return count;
+}
+
+int64_t TrajectoryEncoder::GetFirstMs() const {
+    return firstMs;
+}
+
+int64_t TrajectoryEncoder::GetLastMs() const {
+    return lastMs;
+}
+
+bool TrajectoryEncoder::IsEmpty() const {
+    return count == 0;
+}
+
+void TrajectoryEncoder::Clear() {
+    data.clear();
+    count = 0;
+}
+
+namespace Trajectory {
+    std::vector<TrajectoryPoint> Decode(std::span<const uint8_t> data) {
+        std::vector<TrajectoryPoint> points;
+        size_t position = 0;
+
+        int64_t timeMs = 0;
+        int64_t last[3] = {};
+        int64_t lastStep[3] = {};
+
+        while (position < data.size()) {
+            uint64_t raw = 0;
+            if (!GetVarint(data, position, raw)) {
+                return {};
+            }
+            timeMs = points.empty() ? static_cast<int64_t>(raw) : timeMs + static_cast<int64_t>(raw);
+
+            for (int axis = 0; axis < 3; ++axis) {
+                if (!GetVarint(data, position, raw)) {
+                    return {};
+                }
+
+                if (points.empty()) {
+                    last[axis] = UnZigZag(raw);
+                } else {
+                    lastStep[axis] += UnZigZag(raw);
+                    last[axis] += lastStep[axis];
+                }
+            }
+
+            points.push_back({
+                timeMs,
+                static_cast<float>(last[0]) * TrajectoryEncoder::QUANTUM,
+                static_cast<float>(last[1]) * TrajectoryEncoder::QUANTUM,
+                static_cast<float>(last[2]) * TrajectoryEncoder::QUANTUM
+            });
+        }
+
+        return points;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct TrajectoryPoint {
+    int64_t timeMs;     // Unix time
+    float x;
+    float y;
+    float z;
+};
+
+// Append-only encoding of player positions. Coordinates are quantized to QUANTUM metres; the
+// first point of a buffer is stored whole, then each point as varints: the milliseconds since
+// the previous point and, per axis, how far the step differs from the previous step (zigzag).
+// Walking in a straight line at a steady rate encodes as about four bytes a point, and a
+// point that did not move from the last one is not stored at all.
+class TrajectoryEncoder {
+private:
+    std::vector<uint8_t> data;
+    size_t count = 0;
+    int64_t firstMs = 0;
+    int64_t lastMs = 0;
+    int32_t last[3] = {};
+    int32_t lastStep[3] = {};
+
+public:
+    static constexpr float QUANTUM = 0.05f;
+
+    // Returns false if the point was dropped for not moving.
+    bool Append(const TrajectoryPoint& point);
+
+    std::span<const uint8_t> GetData() const;
+    size_t GetCount() const;
+    int64_t GetFirstMs() const;
+    int64_t GetLastMs() const;
+    bool IsEmpty() const;
+
+    // Starts a new, independently decodable buffer.
+    void Clear();
+};
+
+namespace Trajectory {
+    // Empty on malformed data.
+    std::vector<TrajectoryPoint> Decode(std::span<const uint8_t> data);
+}
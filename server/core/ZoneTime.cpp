@@ -0,0 +1,55 @@
+#include "ZoneTime.h"
+
+#include <algorithm>
+
+size_t ZoneTimeAccumulator::IndexOf(uint32_t zoneId) {
+    auto it = std::find(zoneIds.begin(), zoneIds.end(), zoneId);
+    if (it != zoneIds.end()) {
+        return static_cast<size_t>(it - zoneIds.begin());
+    }
+
+    zoneIds.push_back(zoneId);
+    elapsed.push_back(Clock::duration::zero());
+    return zoneIds.size() - 1;
+}
+
+void ZoneTimeAccumulator::Sample(uint32_t zoneId, Clock::time_point sampledAt) {
+    if (lastIndex != NO_ZONE && sampledAt > lastSampledAt) {
+        elapsed[lastIndex] += std::min<Clock::duration>(sampledAt - lastSampledAt, MAX_SAMPLE_GAP);
+    }
+    lastSampledAt = sampledAt;
+
+    if (zoneId == 0) {
+        lastIndex = NO_ZONE;
+    } else if (lastIndex == NO_ZONE || zoneId != lastZoneId) {
+        lastIndex = IndexOf(zoneId);
+    }
+    lastZoneId = zoneId;
+}
+
+void ZoneTimeAccumulator::Pause() {
+    lastIndex = NO_ZONE;
+}
+
+void ZoneTimeAccumulator::Take(std::vector<ZoneTimeDelta>& out) {
+    for (size_t i = 0; i < zoneIds.size(); ++i) {
+        auto wholeMs = std::chrono::floor<std::chrono::milliseconds>(elapsed[i]);
+        if (wholeMs.count() <= 0) {
+            continue;
+        }
+        out.push_back({zoneIds[i], wholeMs.count()});
+        elapsed[i] -= wholeMs;
+    }
+}
+
+bool ZoneTimeAccumulator::IsEmpty() const {
+    return std::none_of(elapsed.begin(), elapsed.end(),
+        [](Clock::duration time) { return time >= std::chrono::milliseconds(1); });
+}
+
+void ZoneTimeAccumulator::Reset() {
+    zoneIds.clear();
+    elapsed.clear();
+    lastZoneId = 0;
+    lastIndex = NO_ZONE;
+}
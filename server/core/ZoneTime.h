@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ZoneTimeDelta {
+    uint32_t zoneId;
+    int64_t timeMs;
+};
+
+// Time one character spends in each play region, between flushes. Each region visited gets a
+// dense index on first sight and its time lives in a flat array; the current region's index
+// is kept, so a sample in the same region as the last one only subtracts two timestamps and
+// adds to one slot. A new region is looked up by a scan of the regions seen so far, which
+// happens once per zone change.
+//
+// The time between two samples counts toward the region of the earlier one, as the player was
+// there until the later sample saw otherwise. Not thread-safe.
+class ZoneTimeAccumulator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // A longer gap between samples (the game stalled, the machine slept) counts only this much.
+    static constexpr auto MAX_SAMPLE_GAP = std::chrono::seconds(5);
+
+private:
+    static constexpr size_t NO_ZONE = SIZE_MAX;
+
+    std::vector<uint32_t> zoneIds;          // dense index -> play region id
+    std::vector<Clock::duration> elapsed;   // by dense index, since the last Take
+
+    uint32_t lastZoneId = 0;
+    size_t lastIndex = NO_ZONE;
+    Clock::time_point lastSampledAt{};
+
+    size_t IndexOf(uint32_t zoneId);
+
+public:
+    // The player is in zoneId at sampledAt; zone 0, or any sample for which Pause was called
+    // first, starts counting afresh. Samples must not go back in time.
+    void Sample(uint32_t zoneId, Clock::time_point sampledAt);
+
+    // Time up to the next sample is not counted (loading screens, menus, no character).
+    void Pause();
+
+    // Appends whole milliseconds per region with any, and keeps the remainders.
+    void Take(std::vector<ZoneTimeDelta>& out);
+
+    bool IsEmpty() const;
+
+    // Forgets every region, for the next character.
+    void Reset();
+};
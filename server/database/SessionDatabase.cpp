@@ -26,6 +26,7 @@ bool SessionDatabase::CreateTables() {
             session_deaths INTEGER,
             deaths_per_hour REAL,
             character_id INTEGER,
+            instance_id INTEGER DEFAULT 0,
             FOREIGN KEY (character_id) REFERENCES characters(id)
         )
     )";
@@ -47,6 +48,22 @@ bool SessionDatabase::CreateTables() {
             character_id INTEGER,
             timestamp TEXT,
             is_boss_death INTEGER DEFAULT 0,
+            instance_id INTEGER DEFAULT 0,
+            boss_hp_percent REAL,
+            died_at_ms INTEGER DEFAULT 0,
+            FOREIGN KEY (character_id) REFERENCES characters(id)
+        )
+    )";
+
+    const char* openSessionsSql = R"(
+        CREATE TABLE IF NOT EXISTS open_sessions (
+            instance_id INTEGER PRIMARY KEY,
+            start_time TEXT,
+            checkpoint_time TEXT,
+            duration_ms INTEGER,
+            starting_deaths INTEGER,
+            ending_deaths INTEGER,
+            character_id INTEGER,
             FOREIGN KEY (character_id) REFERENCES characters(id)
         )
     )";
@@ -69,6 +86,49 @@ bool SessionDatabase::CreateTables() {
       )
     )";
 
+    const char* trajectoryChunksSql = R"(
+        CREATE TABLE IF NOT EXISTS trajectory_chunks (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            instance_id INTEGER,
+            character_id INTEGER,
+            session_start TEXT,
+            start_ms INTEGER,
+            end_ms INTEGER,
+            point_count INTEGER,
+            data BLOB,
+            FOREIGN KEY (character_id) REFERENCES characters(id)
+        );
+        CREATE INDEX IF NOT EXISTS trajectory_chunks_by_time ON trajectory_chunks(instance_id, start_ms);
+    )";
+
+    const char* inventoryLedgerSql = R"(
+        CREATE TABLE IF NOT EXISTS inventory_ledger (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            character_id INTEGER,
+            instance_id INTEGER,
+            kind TEXT,
+            item_id INTEGER,
+            slot INTEGER,
+            delta INTEGER,
+            quantity INTEGER,
+            changed_at_ms INTEGER,
+            is_baseline INTEGER DEFAULT 0,
+            FOREIGN KEY (character_id) REFERENCES characters(id)
+        );
+        CREATE INDEX IF NOT EXISTS inventory_ledger_by_character ON inventory_ledger(character_id, id);
+    )";
+
+    const char* zoneTimeSql = R"(
+        CREATE TABLE IF NOT EXISTS zone_time (
+            character_id INTEGER,
+            zone_id INTEGER,
+            time_ms INTEGER,
+            updated_at TEXT,
+            PRIMARY KEY (character_id, zone_id),
+            FOREIGN KEY (character_id) REFERENCES characters(id)
+        )
+    )";
+
     char* errMsg = nullptr;
 
     if (sqlite3_exec(db, charactersSql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
@@ -89,6 +149,12 @@ bool SessionDatabase::CreateTables() {
         return false;
     }
 
+    if (sqlite3_exec(db, openSessionsSql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to create open_sessions table: " + std::string(errMsg));
+        sqlite3_free(errMsg);
+        return false;
+    }
+
     if (sqlite3_exec(db, deathsSql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
         log(LogLevel::ERR, "Failed to create deaths table: " + std::string(errMsg));
         sqlite3_free(errMsg);
@@ -100,9 +166,72 @@ bool SessionDatabase::CreateTables() {
         return false;
     }
 
+    if (sqlite3_exec(db, trajectoryChunksSql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to create trajectory_chunks table: " + std::string(errMsg));
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    if (sqlite3_exec(db, inventoryLedgerSql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to create inventory_ledger table: " + std::string(errMsg));
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    if (sqlite3_exec(db, zoneTimeSql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to create zone_time table: " + std::string(errMsg));
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    return true;
+}
+
+bool SessionDatabase::AddColumnIfMissing(const char* table, const char* column, const char* definition) {
+    std::string infoSql = "PRAGMA table_info(" + std::string(table) + ")";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, infoSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to inspect " + std::string(table) + " table");
+        return false;
+    }
+
+    bool exists = false;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const unsigned char* name = sqlite3_column_text(stmt, 1);
+        if (name && std::string(reinterpret_cast<const char*>(name)) == column) {
+            exists = true;
+            break;
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    if (exists) {
+        return true;
+    }
+
+    std::string alterSql = "ALTER TABLE " + std::string(table) + " ADD COLUMN " + column + " " + definition;
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, alterSql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to add " + std::string(table) + "." + column + ": " + std::string(errMsg));
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    log(LogLevel::INFO, "Added column " + std::string(table) + "." + column);
     return true;
 }
 
+// Columns added after the first release; databases created by CreateTables already have them.
+bool SessionDatabase::MigrateTables() {
+    return AddColumnIfMissing("sessions", "instance_id", "INTEGER DEFAULT 0")
+        && AddColumnIfMissing("deaths", "instance_id", "INTEGER DEFAULT 0")
+        && AddColumnIfMissing("deaths", "boss_hp_percent", "REAL")
+        && AddColumnIfMissing("deaths", "died_at_ms", "INTEGER DEFAULT 0")
+        && AddColumnIfMissing("inventory_ledger", "is_baseline", "INTEGER DEFAULT 0");
+}
+
 bool SessionDatabase::Open() {
     int result = sqlite3_open(DB_FILE, &db);
     if (result != SQLITE_OK) {
@@ -110,29 +239,49 @@ bool SessionDatabase::Open() {
         return false;
     }
 
-    if (!CreateTables()) {
+    // A commit in WAL mode only appends to the log, without the fsyncs of a rollback journal,
+    // which keeps session checkpoints cheap. A crash of Ember cannot lose a commit; a power
+    // loss can lose the last few, never the database.
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        log(LogLevel::WARN, "Failed to enable WAL journal: " + std::string(errMsg));
+        sqlite3_free(errMsg);
+    }
+
+    if (!CreateTables() || !MigrateTables()) {
         return false;
     }
 
+    RecoverOpenSessions();
+
     log(LogLevel::INFO, "Database opened");
     return true;
 }
 
-bool SessionDatabase::SaveSession(const std::string& startTime, const std::string& endTime, int durationMs, int startingDeaths, int endingDeaths, int characterId) {
+bool SessionDatabase::SaveSession(const std::string& startTime, const std::string& endTime, int durationMs, int startingDeaths, int endingDeaths, int characterId, int instanceId) {
     int sessionDeaths = endingDeaths - startingDeaths;
     double deathsPerHour = Stats::CalculateDeathsPerHour(sessionDeaths, durationMs);
 
     const char* sql = R"(
-        INSERT INTO sessions(start_time, end_time, duration_ms, starting_deaths, ending_deaths, session_deaths, deaths_per_hour, character_id)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+        INSERT INTO sessions(start_time, end_time, duration_ms, starting_deaths, ending_deaths, session_deaths, deaths_per_hour, character_id, instance_id)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
     )";
 
+    const char* dropCheckpointSql = "DELETE FROM open_sessions WHERE instance_id = ?";
+
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
         log(LogLevel::ERR, "Failed to prepare statement");
         return false;
     }
 
+    sqlite3_stmt* dropStmt;
+    if (sqlite3_prepare_v2(db, dropCheckpointSql, -1, &dropStmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare SaveSession checkpoint removal");
+        sqlite3_finalize(stmt);
+        return false;
+    }
+
     sqlite3_bind_text(stmt, 1, startTime.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 2, endTime.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 3, durationMs);
@@ -141,11 +290,18 @@ bool SessionDatabase::SaveSession(const std::string& startTime, const std::strin
     sqlite3_bind_int(stmt, 6, sessionDeaths);
     sqlite3_bind_double(stmt, 7, deathsPerHour);
     sqlite3_bind_int(stmt, 8, characterId);
+    sqlite3_bind_int(stmt, 9, instanceId);
+    sqlite3_bind_int(dropStmt, 1, instanceId);
 
-    int result = sqlite3_step(stmt);
+    sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr);
+
+    bool saved = sqlite3_step(stmt) == SQLITE_DONE && sqlite3_step(dropStmt) == SQLITE_DONE;
     sqlite3_finalize(stmt);
+    sqlite3_finalize(dropStmt);
 
-    if (result != SQLITE_DONE) {
+    sqlite3_exec(db, saved ? "COMMIT" : "ROLLBACK", nullptr, nullptr, nullptr);
+
+    if (!saved) {
         log(LogLevel::ERR, "Failed to save session");
         return false;
     }
@@ -178,6 +334,89 @@ bool SessionDatabase::UpdatePlayerStats(int totalDeaths, int totalPlaytimeMs) {
     return result == SQLITE_DONE;
 }
 
+bool SessionDatabase::CheckpointSession(const SessionCheckpoint& checkpoint) {
+    const char* sql = R"(
+        INSERT OR REPLACE INTO open_sessions(instance_id, start_time, checkpoint_time, duration_ms, starting_deaths, ending_deaths, character_id)
+        VALUES (?, ?, ?, ?, ?, ?, ?)
+    )";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare CheckpointSession");
+        return false;
+    }
+
+    std::string timestamp = Stats::GetCurrentTimestamp();
+
+    sqlite3_bind_int(stmt, 1, checkpoint.instanceId);
+    sqlite3_bind_text(stmt, 2, checkpoint.startTime.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 3, timestamp.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 4, checkpoint.durationMs);
+    sqlite3_bind_int(stmt, 5, checkpoint.startingDeaths);
+    sqlite3_bind_int(stmt, 6, checkpoint.endingDeaths);
+    sqlite3_bind_int(stmt, 7, checkpoint.characterId);
+
+    sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr);
+
+    bool saved = sqlite3_step(stmt) == SQLITE_DONE;
+    sqlite3_finalize(stmt);
+
+    // player_stats is a single row backing /api/stats, which follows instance 0.
+    if (saved && checkpoint.instanceId == 0) {
+        saved = UpdatePlayerStats(checkpoint.endingDeaths, checkpoint.totalPlaytimeMs);
+    }
+    if (saved && checkpoint.characterId > 0 && checkpoint.stats) {
+        saved = SaveCharacterStats(checkpoint.characterId, *checkpoint.stats);
+    }
+
+    sqlite3_exec(db, saved ? "COMMIT" : "ROLLBACK", nullptr, nullptr, nullptr);
+
+    if (!saved) {
+        log(LogLevel::ERR, "Failed to checkpoint session");
+    }
+    return saved;
+}
+
+// Sessions still open here were cut short by a crash; each becomes a session that ended at
+// its last checkpoint. player_stats and character_stats were kept current by the checkpoints.
+void SessionDatabase::RecoverOpenSessions() {
+    const char* sql = R"(
+        SELECT instance_id, start_time, checkpoint_time, duration_ms, starting_deaths, ending_deaths, character_id
+        FROM open_sessions
+    )";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare RecoverOpenSessions");
+        return;
+    }
+
+    std::vector<Session> open;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        Session session{};
+        session.instanceId = sqlite3_column_int(stmt, 0);
+        if (auto text = sqlite3_column_text(stmt, 1)) {
+            session.startTime = reinterpret_cast<const char*>(text);
+        }
+        if (auto text = sqlite3_column_text(stmt, 2)) {
+            session.endTime = reinterpret_cast<const char*>(text);
+        }
+        session.durationMs = sqlite3_column_int(stmt, 3);
+        session.startingDeaths = sqlite3_column_int(stmt, 4);
+        session.endingDeaths = sqlite3_column_int(stmt, 5);
+        session.characterId = sqlite3_column_int(stmt, 6);
+        open.push_back(std::move(session));
+    }
+    sqlite3_finalize(stmt);
+
+    for (const Session& session : open) {
+        log(LogLevel::WARN, "Recovering session of instance " + std::to_string(session.instanceId) +
+            " interrupted after " + session.endTime);
+        SaveSession(session.startTime, session.endTime, session.durationMs, session.startingDeaths,
+            session.endingDeaths, session.characterId, session.instanceId);
+    }
+}
+
 std::optional<PlayerStats> SessionDatabase::GetPlayerStats() {
     const char* sql = "SELECT total_deaths, total_playtime_ms, last_updated FROM player_stats WHERE id = 1";
 
@@ -205,51 +444,75 @@ std::optional<PlayerStats> SessionDatabase::GetPlayerStats() {
     return stats;
 }
 
+static constexpr const char* SESSION_COLUMNS =
+    "id, start_time, end_time, duration_ms, starting_deaths, ending_deaths, session_deaths, deaths_per_hour, character_id, instance_id";
+
+static Session ReadSession(sqlite3_stmt* stmt) {
+    Session session;
+    session.id = sqlite3_column_int(stmt, 0);
+
+    if (auto text = sqlite3_column_text(stmt, 1)) {
+        session.startTime = reinterpret_cast<const char*>(text);
+    }
+
+    if (auto text = sqlite3_column_text(stmt, 2)) {
+        session.endTime = reinterpret_cast<const char*>(text);
+    }
+
+    session.durationMs = sqlite3_column_int(stmt, 3);
+    session.startingDeaths = sqlite3_column_int(stmt, 4);
+    session.endingDeaths = sqlite3_column_int(stmt, 5);
+    session.sessionDeaths = sqlite3_column_int(stmt, 6);
+    session.deathsPerHour = sqlite3_column_double(stmt, 7);
+    session.characterId = sqlite3_column_int(stmt, 8);
+    session.instanceId = sqlite3_column_int(stmt, 9);
+    return session;
+}
+
 std::vector<Session> SessionDatabase::GetAllSessions() {
     std::vector<Session> sessions;
 
-    const char* sql = R"(
-        SELECT id, start_time, end_time, duration_ms, starting_deaths, ending_deaths, session_deaths, deaths_per_hour, character_id
-        FROM sessions
-        ORDER BY id DESC
-    )";
+    std::string sql = "SELECT " + std::string(SESSION_COLUMNS) + " FROM sessions ORDER BY id DESC";
 
     sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
         log(LogLevel::ERR, "Failed to prepare GetAllSessions");
         return sessions;
     }
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Session session;
-        session.id = sqlite3_column_int(stmt, 0);
+        sessions.push_back(ReadSession(stmt));
+    }
 
-        if (auto text = sqlite3_column_text(stmt, 1)) {
-            session.startTime = reinterpret_cast<const char*>(text);
-        }
+    sqlite3_finalize(stmt);
+    return sessions;
+}
 
-        if (auto text = sqlite3_column_text(stmt, 2)) {
-            session.endTime = reinterpret_cast<const char*>(text);
-        }
+std::optional<Session> SessionDatabase::GetSession(int id) {
+    std::string sql = "SELECT " + std::string(SESSION_COLUMNS) + " FROM sessions WHERE id = ?";
 
-        session.durationMs = sqlite3_column_int(stmt, 3);
-        session.startingDeaths = sqlite3_column_int(stmt, 4);
-        session.endingDeaths = sqlite3_column_int(stmt, 5);
-        session.sessionDeaths = sqlite3_column_int(stmt, 6);
-        session.deathsPerHour = sqlite3_column_double(stmt, 7);
-        session.characterId = sqlite3_column_int(stmt, 8);
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare GetSession");
+        return std::nullopt;
+    }
 
-        sessions.push_back(session);
+    sqlite3_bind_int(stmt, 1, id);
+
+    std::optional<Session> session;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        session = ReadSession(stmt);
     }
 
     sqlite3_finalize(stmt);
-    return sessions;
+    return session;
 }
 
-bool SessionDatabase::SaveDeath(uint32_t zoneId, const std::string& zoneName, int characterId, bool isBossDeath) {
+bool SessionDatabase::SaveDeath(uint32_t zoneId, const std::string& zoneName, int characterId, bool isBossDeath,
+    std::chrono::system_clock::time_point diedAt, int instanceId, std::optional<double> bossHpPercent) {
     const char* sql = R"(
-        INSERT INTO deaths(zone_id, zone_name, character_id, timestamp, is_boss_death)
-        VALUES (?, ?, ?, ?, ?)
+        INSERT INTO deaths(zone_id, zone_name, character_id, timestamp, is_boss_death, instance_id, boss_hp_percent, died_at_ms)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?)
     )";
 
     sqlite3_stmt* stmt;
@@ -258,13 +521,20 @@ bool SessionDatabase::SaveDeath(uint32_t zoneId, const std::string& zoneName, in
         return false;
     }
 
-    std::string timestamp = Stats::GetCurrentTimestamp();
+    std::string timestamp = Stats::FormatTimestampMs(diedAt);
 
     sqlite3_bind_int(stmt, 1, static_cast<int>(zoneId));
     sqlite3_bind_text(stmt, 2, zoneName.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 3, characterId);
     sqlite3_bind_text(stmt, 4, timestamp.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 5, isBossDeath ? 1 : 0);
+    sqlite3_bind_int(stmt, 6, instanceId);
+    if (bossHpPercent) {
+        sqlite3_bind_double(stmt, 7, *bossHpPercent);
+    } else {
+        sqlite3_bind_null(stmt, 7);
+    }
+    sqlite3_bind_int64(stmt, 8, std::chrono::duration_cast<std::chrono::milliseconds>(diedAt.time_since_epoch()).count());
 
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -274,17 +544,41 @@ bool SessionDatabase::SaveDeath(uint32_t zoneId, const std::string& zoneName, in
         return false;
     }
 
-    log(LogLevel::INFO, "Death saved: " + zoneName + (isBossDeath ? " (boss)" : ""));
+    std::string bossHpText = bossHpPercent ? " (boss at " + std::to_string(static_cast<int>(*bossHpPercent + 0.5)) + "%)" : "";
+    log(LogLevel::INFO, "Death saved: " + zoneName + (isBossDeath ? " (boss)" : "") + bossHpText);
     return true;
 }
 
+static constexpr const char* DEATH_COLUMNS =
+    "id, zone_id, zone_name, character_id, timestamp, is_boss_death, instance_id, boss_hp_percent, died_at_ms";
+
+static Death ReadDeath(sqlite3_stmt* stmt) {
+    Death death;
+    death.id = sqlite3_column_int(stmt, 0);
+    death.zoneId = static_cast<uint32_t>(sqlite3_column_int(stmt, 1));
+
+    if (const unsigned char* nameText = sqlite3_column_text(stmt, 2)) {
+        death.zoneName = reinterpret_cast<const char*>(nameText);
+    }
+
+    death.characterId = sqlite3_column_int(stmt, 3);
+
+    if (const unsigned char* timestampText = sqlite3_column_text(stmt, 4)) {
+        death.timestamp = reinterpret_cast<const char*>(timestampText);
+    }
+
+    death.isBossDeath = sqlite3_column_int(stmt, 5) != 0;
+    death.instanceId = sqlite3_column_int(stmt, 6);
+    death.bossHpPercent = sqlite3_column_type(stmt, 7) == SQLITE_NULL
+        ? std::nullopt : std::optional<double>(sqlite3_column_double(stmt, 7));
+    death.diedAtMs = sqlite3_column_int64(stmt, 8);
+    return death;
+}
+
 std::vector<Death> SessionDatabase::GetAllDeaths(std::optional<int> characterId) {
     std::vector<Death> deaths;
 
-    std::string sql = R"(
-        SELECT id, zone_id, zone_name, character_id, timestamp, is_boss_death
-        FROM deaths
-    )";
+    std::string sql = "SELECT " + std::string(DEATH_COLUMNS) + " FROM deaths";
 
     if (characterId) {
         sql += " WHERE character_id = ?";
@@ -303,27 +597,31 @@ std::vector<Death> SessionDatabase::GetAllDeaths(std::optional<int> characterId)
     }
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Death death;
-        death.id = sqlite3_column_int(stmt, 0);
-        death.zoneId = static_cast<uint32_t>(sqlite3_column_int(stmt, 1));
+        deaths.push_back(ReadDeath(stmt));
+    }
 
-        if (const unsigned char* nameText = sqlite3_column_text(stmt, 2)) {
-            death.zoneName = reinterpret_cast<const char*>(nameText);
-        }
+    sqlite3_finalize(stmt);
+    return deaths;
+}
 
-        death.characterId = sqlite3_column_int(stmt, 3);
+std::optional<Death> SessionDatabase::GetDeath(int id) {
+    std::string sql = "SELECT " + std::string(DEATH_COLUMNS) + " FROM deaths WHERE id = ?";
 
-        if (const unsigned char* timestampText = sqlite3_column_text(stmt, 4)) {
-            death.timestamp = reinterpret_cast<const char*>(timestampText);
-        }
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare GetDeath");
+        return std::nullopt;
+    }
 
-        death.isBossDeath = sqlite3_column_int(stmt, 5) != 0;
+    sqlite3_bind_int(stmt, 1, id);
 
-        deaths.push_back(death);
+    std::optional<Death> death;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        death = ReadDeath(stmt);
     }
 
     sqlite3_finalize(stmt);
-    return deaths;
+    return death;
 }
 
 DeathStats SessionDatabase::GetDeathStats(std::optional<int> characterId) {
@@ -638,3 +936,278 @@ void SessionDatabase::Close() {
 SessionDatabase::~SessionDatabase() {
     Close();
 }
+
+bool SessionDatabase::SaveTrajectoryChunk(const TrajectoryChunk& chunk) {
+    const char* sql = R"(
+        INSERT INTO trajectory_chunks(instance_id, character_id, session_start, start_ms, end_ms, point_count, data)
+        VALUES (?, ?, ?, ?, ?, ?, ?)
+    )";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare SaveTrajectoryChunk");
+        return false;
+    }
+
+    sqlite3_bind_int(stmt, 1, chunk.instanceId);
+    sqlite3_bind_int(stmt, 2, chunk.characterId);
+    sqlite3_bind_text(stmt, 3, chunk.sessionStart.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt, 4, chunk.startMs);
+    sqlite3_bind_int64(stmt, 5, chunk.endMs);
+    sqlite3_bind_int(stmt, 6, chunk.pointCount);
+    sqlite3_bind_blob(stmt, 7, chunk.data.data(), static_cast<int>(chunk.data.size()), SQLITE_TRANSIENT);
+
+    int result = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if (result != SQLITE_DONE) {
+        log(LogLevel::ERR, "Failed to save trajectory chunk");
+        return false;
+    }
+
+    return true;
+}
+
+static constexpr const char* TRAJECTORY_COLUMNS =
+    "id, instance_id, character_id, session_start, start_ms, end_ms, point_count, data";
+
+static TrajectoryChunk ReadTrajectoryChunk(sqlite3_stmt* stmt) {
+    TrajectoryChunk chunk;
+    chunk.id = sqlite3_column_int(stmt, 0);
+    chunk.instanceId = sqlite3_column_int(stmt, 1);
+    chunk.characterId = sqlite3_column_int(stmt, 2);
+
+    if (const unsigned char* sessionText = sqlite3_column_text(stmt, 3)) {
+        chunk.sessionStart = reinterpret_cast<const char*>(sessionText);
+    }
+
+    chunk.startMs = sqlite3_column_int64(stmt, 4);
+    chunk.endMs = sqlite3_column_int64(stmt, 5);
+    chunk.pointCount = sqlite3_column_int(stmt, 6);
+
+    auto blob = static_cast<const uint8_t*>(sqlite3_column_blob(stmt, 7));
+    chunk.data.assign(blob, blob + sqlite3_column_bytes(stmt, 7));
+    return chunk;
+}
+
+std::vector<TrajectoryChunk> SessionDatabase::GetSessionTrajectory(int instanceId, const std::string& sessionStart) {
+    std::vector<TrajectoryChunk> chunks;
+
+    std::string sql = "SELECT " + std::string(TRAJECTORY_COLUMNS) +
+        " FROM trajectory_chunks WHERE instance_id = ? AND session_start = ? ORDER BY start_ms";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare GetSessionTrajectory");
+        return chunks;
+    }
+
+    sqlite3_bind_int(stmt, 1, instanceId);
+    sqlite3_bind_text(stmt, 2, sessionStart.c_str(), -1, SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        chunks.push_back(ReadTrajectoryChunk(stmt));
+    }
+
+    sqlite3_finalize(stmt);
+    return chunks;
+}
+
+std::vector<TrajectoryChunk> SessionDatabase::GetTrajectoryBefore(int instanceId, int64_t timeMs, int limit) {
+    std::vector<TrajectoryChunk> chunks;
+
+    std::string sql = "SELECT " + std::string(TRAJECTORY_COLUMNS) +
+        " FROM trajectory_chunks WHERE instance_id = ? AND start_ms <= ? ORDER BY start_ms DESC LIMIT ?";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare GetTrajectoryBefore");
+        return chunks;
+    }
+
+    sqlite3_bind_int(stmt, 1, instanceId);
+    sqlite3_bind_int64(stmt, 2, timeMs);
+    sqlite3_bind_int(stmt, 3, limit);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        chunks.push_back(ReadTrajectoryChunk(stmt));
+    }
+
+    sqlite3_finalize(stmt);
+    return chunks;
+}
+
+bool SessionDatabase::SaveInventoryChanges(const std::vector<InventoryLedgerEntry>& entries) {
+    if (entries.empty()) {
+        return true;
+    }
+
+    const char* sql = R"(
+        INSERT INTO inventory_ledger(character_id, instance_id, kind, item_id, slot, delta, quantity, changed_at_ms, is_baseline)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare SaveInventoryChanges");
+        return false;
+    }
+
+    sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr);
+
+    bool saved = true;
+    for (const InventoryLedgerEntry& entry : entries) {
+        sqlite3_bind_int(stmt, 1, entry.characterId);
+        sqlite3_bind_int(stmt, 2, entry.instanceId);
+        sqlite3_bind_text(stmt, 3, entry.kind.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 4, entry.itemId);
+        sqlite3_bind_int(stmt, 5, entry.slot);
+        sqlite3_bind_int64(stmt, 6, entry.delta);
+        sqlite3_bind_int64(stmt, 7, entry.quantity);
+        sqlite3_bind_int64(stmt, 8, entry.changedAtMs);
+        sqlite3_bind_int(stmt, 9, entry.isBaseline ? 1 : 0);
+
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            saved = false;
+            break;
+        }
+        sqlite3_reset(stmt);
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_exec(db, saved ? "COMMIT" : "ROLLBACK", nullptr, nullptr, nullptr);
+
+    if (!saved) {
+        log(LogLevel::ERR, "Failed to save inventory changes");
+    }
+    return saved;
+}
+
+std::vector<InventoryLedgerEntry> SessionDatabase::GetInventoryLedger(std::optional<int> characterId, int64_t afterId, int limit) {
+    std::vector<InventoryLedgerEntry> entries;
+
+    std::string sql = R"(
+        SELECT id, character_id, instance_id, kind, item_id, slot, delta, quantity, changed_at_ms, is_baseline
+        FROM inventory_ledger WHERE id > ?
+    )";
+    if (characterId) {
+        sql += " AND character_id = ?";
+    }
+    sql += " ORDER BY id LIMIT ?";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare GetInventoryLedger");
+        return entries;
+    }
+
+    int param = 1;
+    sqlite3_bind_int64(stmt, param++, afterId);
+    if (characterId) {
+        sqlite3_bind_int(stmt, param++, *characterId);
+    }
+    sqlite3_bind_int(stmt, param, limit);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        InventoryLedgerEntry entry;
+        entry.id = sqlite3_column_int64(stmt, 0);
+        entry.characterId = sqlite3_column_int(stmt, 1);
+        entry.instanceId = sqlite3_column_int(stmt, 2);
+
+        if (const unsigned char* kindText = sqlite3_column_text(stmt, 3)) {
+            entry.kind = reinterpret_cast<const char*>(kindText);
+        }
+
+        entry.itemId = static_cast<uint32_t>(sqlite3_column_int64(stmt, 4));
+        entry.slot = sqlite3_column_int(stmt, 5);
+        entry.delta = sqlite3_column_int64(stmt, 6);
+        entry.quantity = sqlite3_column_int64(stmt, 7);
+        entry.changedAtMs = sqlite3_column_int64(stmt, 8);
+        entry.isBaseline = sqlite3_column_int(stmt, 9) != 0;
+        entries.push_back(entry);
+    }
+
+    sqlite3_finalize(stmt);
+    return entries;
+}
+
+bool SessionDatabase::AddZoneTimes(int characterId, const std::vector<ZoneTime>& times) {
+    if (times.empty()) {
+        return true;
+    }
+
+    const char* sql = R"(
+        INSERT INTO zone_time(character_id, zone_id, time_ms, updated_at)
+        VALUES (?, ?, ?, ?)
+        ON CONFLICT(character_id, zone_id) DO UPDATE SET
+            time_ms = time_ms + excluded.time_ms,
+            updated_at = excluded.updated_at
+    )";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare AddZoneTimes");
+        return false;
+    }
+
+    std::string timestamp = Stats::GetCurrentTimestamp();
+
+    sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr);
+
+    bool saved = true;
+    for (const ZoneTime& time : times) {
+        sqlite3_bind_int(stmt, 1, characterId);
+        sqlite3_bind_int64(stmt, 2, time.zoneId);
+        sqlite3_bind_int64(stmt, 3, time.timeMs);
+        sqlite3_bind_text(stmt, 4, timestamp.c_str(), -1, SQLITE_TRANSIENT);
+
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            saved = false;
+            break;
+        }
+        sqlite3_reset(stmt);
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_exec(db, saved ? "COMMIT" : "ROLLBACK", nullptr, nullptr, nullptr);
+
+    if (!saved) {
+        log(LogLevel::ERR, "Failed to save zone times");
+    }
+    return saved;
+}
+
+std::vector<ZoneTime> SessionDatabase::GetZoneTimes(std::optional<int> characterId) {
+    std::vector<ZoneTime> times;
+
+    std::string sql = "SELECT zone_id, SUM(time_ms), MAX(updated_at) FROM zone_time";
+    if (characterId) {
+        sql += " WHERE character_id = ?";
+    }
+    sql += " GROUP BY zone_id ORDER BY SUM(time_ms) DESC";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        log(LogLevel::ERR, "Failed to prepare GetZoneTimes");
+        return times;
+    }
+
+    if (characterId) {
+        sqlite3_bind_int(stmt, 1, *characterId);
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        ZoneTime time;
+        time.zoneId = static_cast<uint32_t>(sqlite3_column_int64(stmt, 0));
+        time.timeMs = sqlite3_column_int64(stmt, 1);
+
+        if (const unsigned char* updatedText = sqlite3_column_text(stmt, 2)) {
+            time.updatedAt = reinterpret_cast<const char*>(updatedText);
+        }
+
+        times.push_back(time);
+    }
+
+    sqlite3_finalize(stmt);
+    return times;
+}
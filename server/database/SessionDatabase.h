@@ -2,6 +2,7 @@
 
 #include "sqlite3.h"
 
+#include <chrono>
 #include <cstdint>
 #include <map>
 #include <optional>
@@ -18,6 +19,7 @@ struct Session {
     int sessionDeaths;
     double deathsPerHour;
     int characterId;
+    int instanceId;
 };
 
 struct PlayerStats {
@@ -33,6 +35,47 @@ struct Death {
     int characterId;
     std::string timestamp;
     bool isBossDeath;
+    int instanceId;
+    std::optional<double> bossHpPercent;    // boss HP left when the player died, if a boss was tracked
+    int64_t diedAtMs;                       // Unix time in ms, 0 for deaths saved before it was recorded
+};
+
+// A run of encoded player positions (see Trajectory.h) from one session. Sessions append a
+// chunk every minute and on each death, so a crash loses at most the last minute.
+struct TrajectoryChunk {
+    int id;
+    int instanceId;
+    int characterId;
+    std::string sessionStart;   // start_time of the session row written when the session ends
+    int64_t startMs;
+    int64_t endMs;
+    int pointCount;
+    std::vector<uint8_t> data;
+};
+
+// One change to a character's souls, items or equipment (see InventoryTracker.h). Whenever
+// the character is first seen in a process, a baseline lists everything held as changes from
+// nothing; a character's holdings of a kind at any time are the deltas from its latest
+// baseline of that kind on.
+struct InventoryLedgerEntry {
+    int64_t id;
+    int characterId;
+    int instanceId;
+    std::string kind;       // "item", "souls" or "equip"
+    uint32_t itemId;        // 0 for souls
+    int slot;               // inventory or equip slot, -1 for souls
+    int64_t delta;
+    int64_t quantity;       // after the change
+    int64_t changedAtMs;    // Unix time in ms
+    bool isBaseline;        // delta equals quantity
+};
+
+// Time characters have spent in one play region, summed over sessions. Written every minute
+// and when a session ends.
+struct ZoneTime {
+    uint32_t zoneId;
+    int64_t timeMs;
+    std::string updatedAt;
 };
 
 struct Character {
@@ -57,6 +100,19 @@ struct CharacterStatsRecord {
     std::string updatedAt;
 };
 
+// A session still running, checkpointed every few seconds so a crash loses at most that much.
+// The next Open closes it as a session ending at its last checkpoint.
+struct SessionCheckpoint {
+    int instanceId;
+    std::string startTime;
+    int durationMs;
+    int startingDeaths;
+    int endingDeaths;
+    int characterId;
+    int totalPlaytimeMs;                            // kept in player_stats for instance 0
+    std::optional<CharacterStatsRecord> stats;      // kept in character_stats
+};
+
 struct DeathStats {
     int total;
     int bossDeaths;
@@ -69,6 +125,9 @@ private:
     static constexpr const char* DB_FILE = "sessions.db";
 
     bool CreateTables();
+    bool MigrateTables();
+    bool AddColumnIfMissing(const char* table, const char* column, const char* definition);
+    void RecoverOpenSessions();
 
 public:
     SessionDatabase() = default;
@@ -79,17 +138,39 @@ public:
     ~SessionDatabase();
 
     bool Open();
-    bool SaveSession(const std::string& startTime, const std::string& endTime, int durationMs, int startingDeaths, int endingDeaths, int characterId);
+    // Also drops the instance's checkpoint, in the same transaction.
+    bool SaveSession(const std::string& startTime, const std::string& endTime, int durationMs, int startingDeaths, int endingDeaths, int characterId, int instanceId = 0);
     bool UpdatePlayerStats(int totalDeaths, int totalPlaytimeMs);
+    // Upserts the open_sessions row, player_stats and character_stats in one transaction.
+    bool CheckpointSession(const SessionCheckpoint& checkpoint);
     std::optional<PlayerStats> GetPlayerStats();
     std::vector<Session> GetAllSessions();
-    bool SaveDeath(uint32_t zoneId, const std::string& zoneName, int characterId, bool isBossDeath);
+    std::optional<Session> GetSession(int id);
+    bool SaveDeath(uint32_t zoneId, const std::string& zoneName, int characterId, bool isBossDeath,
+        std::chrono::system_clock::time_point diedAt, int instanceId = 0,
+        std::optional<double> bossHpPercent = std::nullopt);
     std::vector<Death> GetAllDeaths(std::optional<int> characterId = std::nullopt);
+    std::optional<Death> GetDeath(int id);
     DeathStats GetDeathStats(std::optional<int> characterId = std::nullopt);
     std::map<std::string, int> GetDeathsByZone(std::optional<int> characterId = std::nullopt);
     std::map<std::string, int> GetDeathsByBoss(std::optional<int> characterId = std::nullopt);
     void Close();
 
+    bool SaveTrajectoryChunk(const TrajectoryChunk& chunk);
+    std::vector<TrajectoryChunk> GetSessionTrajectory(int instanceId, const std::string& sessionStart);
+    // The latest chunks of an instance starting at or before timeMs, newest first.
+    std::vector<TrajectoryChunk> GetTrajectoryBefore(int instanceId, int64_t timeMs, int limit);
+
+    // Written in one transaction.
+    bool SaveInventoryChanges(const std::vector<InventoryLedgerEntry>& entries);
+    // Entries after afterId, oldest first.
+    std::vector<InventoryLedgerEntry> GetInventoryLedger(std::optional<int> characterId, int64_t afterId, int limit);
+
+    // Adds each region's time to the character's total, in one transaction.
+    bool AddZoneTimes(int characterId, const std::vector<ZoneTime>& times);
+    // One character's, or summed over all characters; longest first.
+    std::vector<ZoneTime> GetZoneTimes(std::optional<int> characterId = std::nullopt);
+
     int GetOrCreateCharacter(const std::string& name, int classId);
     std::optional<Character> GetCharacter(int id);
     std::vector<Character> GetAllCharacters();
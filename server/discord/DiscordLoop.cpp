@@ -3,91 +3,69 @@
 #include "../core/Log.h"
 #include "../core/Settings.h"
 #include "../core/ZoneNames.h"
-#include "../memory/DS3StatsReader.h"
-#include "../monitoring/GameMonitor.h"
+#include "../monitoring/GameEvents.h"
 
 #include "discord_rpc.h"
 
 #include <chrono>
 
-std::mutex g_discordMutex;
-std::condition_variable g_discordCv;
+static constexpr auto PRESENCE_INTERVAL = std::chrono::seconds(15);
 
-void discordUpdateLoop() {
-    DS3StatsReader statsReader;
-    bool gameConnected = false;
-    uint32_t currentDeaths = 0;
-    uint32_t currentPlaytime = 0;
+static AsyncSignal g_presenceWake;
 
+Task discordUpdateLoop() {
     g_discord.Initialize();
 
-    while (g_running) {
-        std::unique_lock<std::mutex> lock(g_discordMutex);
-
-        if (!g_settings.isDiscordRpcEnabled) {
-            Discord_ClearPresence();
-            g_discordCv.wait_for(lock, std::chrono::seconds(15));
-            continue;
-        }
+    // Presence follows instance 0, as /api/stats does.
+    GameEventBus::Subscription events = g_gameEvents.Subscribe(0);
+    GameStatus status = events.Initial();
+    if (status.isRunning) {
+        g_discord.ResetTimestamp();
+    }
 
-        if (!statsReader.IsInitialized()) {
-            if (statsReader.Initialize()) {
-                gameConnected = true;
+    uint64_t wakeCount = 0;
+    while (!g_executor.IsStopping()) {
+        // Drained even while presence is off, so it is current when turned back on.
+        GameEvent event;
+        while (events.Next(event, std::chrono::milliseconds(0))) {
+            if (event.type == GameEventType::GameDetected) {
                 log(LogLevel::INFO, "Game detected, starting Discord presence");
                 g_discord.ResetTimestamp();
-            } else {
-                if (gameConnected) {
-                    log(LogLevel::WARN, "Game disconnected");
+            } else if (event.type == GameEventType::GameExited) {
+                log(LogLevel::WARN, "Game disconnected");
+                Discord_ClearPresence();
+            } else if (event.type == GameEventType::Resync) {
+                status = events.Initial();
+                if (!status.isRunning) {
                     Discord_ClearPresence();
-                    gameConnected = false;
                 }
-                Discord_RunCallbacks();
-                g_discordCv.wait_for(lock, std::chrono::seconds(15));
                 continue;
             }
+            ApplyGameEvent(status, event);
         }
 
-        if (!statsReader.IsProcessRunning()) {
-            if (gameConnected) {
-                log(LogLevel::WARN, "Game disconnected");
-                Discord_ClearPresence();
-                gameConnected = false;
+        if (!g_settings.isDiscordRpcEnabled) {
+            Discord_ClearPresence();
+        } else if (status.isRunning) {
+            std::string zoneName = "Unknown Area";
+            bool inMainMenu = true;
+            bool isBossZone = false;
+            if (status.zoneId != 0) {
+                zoneName = GetZoneName(status.zoneId);
+                isBossZone = IsBossZone(status.zoneId);
+                inMainMenu = false;
             }
-            statsReader.Reset();
-            Discord_RunCallbacks();
-            g_discordCv.wait_for(lock, std::chrono::seconds(15));
-            continue;
-        }
-
-        auto playtimeResult = statsReader.GetPlayTime();
-        if (playtimeResult) {
-            currentPlaytime = *playtimeResult;
-        }
-
-        auto deathsResult = statsReader.GetDeathCount();
-        if (deathsResult) {
-            currentDeaths = *deathsResult;
-        }
-
-        std::string zoneName = "Unknown Area";
-        bool inMainMenu = true;
-        bool isBossZone = false;
-        auto zoneResult = statsReader.GetPlayRegion();
-        if (zoneResult && *zoneResult != 0) {
-            zoneName = GetZoneName(*zoneResult);
-            isBossZone = IsBossZone(*zoneResult);
-            inMainMenu = false;
-        }
 
-        bool inBossFight = false;
-        auto bossResult = statsReader.GetInBossFight();
-        if (bossResult) {
-            inBossFight = *bossResult;
+            g_discord.Update(status.deaths, status.playtime, zoneName, status.inBossFight, inMainMenu, isBossZone);
+            Discord_RunCallbacks();
+        } else {
+            Discord_RunCallbacks();
         }
 
-        g_discord.Update(currentDeaths, currentPlaytime, zoneName, inBossFight, inMainMenu, isBossZone);
-
-        Discord_RunCallbacks();
-        g_discordCv.wait_for(lock, std::chrono::seconds(15));
+        wakeCount = co_await g_presenceWake.Wait(g_executor, wakeCount, PRESENCE_INTERVAL);
     }
 }
+
+void wakeDiscordPresence() {
+    g_presenceWake.Notify();
+}
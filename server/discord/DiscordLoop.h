@@ -1,9 +1,9 @@
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
+#include "../core/Executor.h"
 
-extern std::mutex g_discordMutex;
-extern std::condition_variable g_discordCv;
+// Spawned on g_executor; refreshes presence every 15 seconds until the executor stops.
+Task discordUpdateLoop();
 
-void discordUpdateLoop();
+// Refreshes presence right away, after a settings change.
+void wakeDiscordPresence();
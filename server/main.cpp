@@ -1,11 +1,12 @@
+#include "core/Executor.h"
 #include "core/Log.h"
 #include "core/Settings.h"
 #include "core/Stats.h"
 #include "database/SessionDatabase.h"
 #include "discord/DiscordLoop.h"
 #include "discord/DiscordPresence.h"
-#include "memory/DS3StatsReader.h"
 #include "monitoring/GameMonitor.h"
+#include "monitoring/InstanceManager.h"
 #include "windows/AutoStart.h"
 #include "windows/BorderlessWindow.h"
 #include "api/Routes.h"
@@ -31,21 +32,23 @@ int main() {
         AutoStart::Enable();
     }
 
-    std::thread monitorThread(gameMonitorLoop);
-    std::thread discordThread(discordUpdateLoop);
+    g_executor.Start();
+    g_executor.Spawn(gameMonitorLoop());
+    g_executor.Spawn(discordUpdateLoop());
+
+    std::thread instanceThread([] { g_instanceManager.Run(); });
 
-    DS3StatsReader statsReader;
     httplib::Server server;
 
-    setupRoutes(server, statsReader, startTime);
+    setupRoutes(server, startTime);
 
     log(LogLevel::INFO, "Starting server on http://localhost:" + std::to_string(SERVER_PORT) + "...");
     server.listen("localhost", SERVER_PORT);
 
     g_running = false;
 
-    monitorThread.join();
-    discordThread.join();
+    instanceThread.join();
+    g_executor.Stop();
 
     g_discord.Shutdown();
     g_sessionDb.Close();
@@ -0,0 +1,66 @@
+#include "BlockDiff.h"
+#include "../core/CpuFeatures.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    using BlockDiff::SPAN_SIZE;
+
+    void ChangedSpansScalar(const uint8_t* previous, const uint8_t* current, size_t size, size_t start,
+        std::vector<uint32_t>& offsets) {
+        for (size_t i = start; i < size; i += SPAN_SIZE) {
+            if (std::memcmp(previous + i, current + i, std::min(SPAN_SIZE, size - i)) != 0) {
+                offsets.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+#ifdef EMBER_SIMD_X64
+    EMBER_TARGET_AVX2 void ChangedSpansAvx2(const uint8_t* previous, const uint8_t* current, size_t size,
+        std::vector<uint32_t>& offsets) {
+        size_t i = 0;
+        for (; i + SPAN_SIZE <= size; i += SPAN_SIZE) {
+            __m256i before = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + i));
+            __m256i after = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + i));
+            __m256i differing = _mm256_xor_si256(before, after);
+            if (!_mm256_testz_si256(differing, differing)) {
+                offsets.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        ChangedSpansScalar(previous, current, size, i, offsets);
+    }
+
+    void ChangedSpansSse2(const uint8_t* previous, const uint8_t* current, size_t size, std::vector<uint32_t>& offsets) {
+        size_t i = 0;
+        for (; i + SPAN_SIZE <= size; i += SPAN_SIZE) {
+            __m128i low = _mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i)));
+            __m128i high = _mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i + 16)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i + 16)));
+            if (_mm_movemask_epi8(_mm_and_si128(low, high)) != 0xFFFF) {
+                offsets.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        ChangedSpansScalar(previous, current, size, i, offsets);
+    }
+#endif
+}
+
+namespace BlockDiff {
+    void ChangedSpans(std::span<const uint8_t> previous, std::span<const uint8_t> current, std::vector<uint32_t>& offsets) {
+        size_t size = std::min(previous.size(), current.size());
+
+#ifdef EMBER_SIMD_X64
+        if (CpuFeatures::HasAvx2()) {
+            ChangedSpansAvx2(previous.data(), current.data(), size, offsets);
+        } else {
+            ChangedSpansSse2(previous.data(), current.data(), size, offsets);
+        }
+#else
+        ChangedSpansScalar(previous.data(), current.data(), size, 0, offsets);
+#endif
+    }
+}
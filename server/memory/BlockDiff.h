@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Locates what changed between two snapshots of a block of game memory, so a tracker only
+// decodes the spans that differ and a quiet block is compared at about memcmp speed.
+namespace BlockDiff {
+    inline constexpr size_t SPAN_SIZE = 32;
+
+    // Appends the offset of every SPAN_SIZE-byte span that differs between two snapshots, in
+    // ascending order; the last span is shorter when the size is not a multiple of SPAN_SIZE.
+    // Spans are compared 32 bytes at a time with AVX2, else SSE2.
+    void ChangedSpans(std::span<const uint8_t> previous, std::span<const uint8_t> current, std::vector<uint32_t>& offsets);
+}
@@ -0,0 +1,141 @@
+#include "BossTracker.h"
+#include "DS3Fields.h"
+#include "MemoryReader.h"
+#include "ReadMetrics.h"
+#include "SnapshotMemorySource.h"
+
+#include <algorithm>
+
+BossTracker::BossTracker()
+    : scanMetric(GetReadMetrics().Register("bossScan")), hpMetric(GetReadMetrics().Register("bossHp")) {}
+
+// One bad character must not fail the whole step, so a failed batch is retried read by read.
+template<MemorySource Source>
+void BossTracker::ReadAll(Source& source) {
+    readSucceeded.assign(reads.size(), true);
+    if (reads.empty() || source.ReadBatch(reads)) {
+        return;
+    }
+
+    for (size_t i = 0; i < reads.size(); ++i) {
+        readSucceeded[i] = source.ReadBatch(std::span<const MemoryRead>(&reads[i], 1));
+    }
+}
+
+template<MemorySource Source>
+void BossTracker::ScanStep(Source& source, uintptr_t listBegin, size_t count, uintptr_t playerHpAddress) {
+    ScopedReadTimer timer(scanMetric);
+
+    size_t step = std::min(SCAN_STEP, count - cursor);
+    characters.assign(step, 0);
+    const MemoryRead slice[] = {{listBegin + cursor * sizeof(uintptr_t), characters.data(), step * sizeof(uintptr_t)}};
+    if (!source.ReadBatch(slice)) {
+        timer.SetSucceeded(false);
+        cursor = count;
+        return;
+    }
+    cursor += step;
+
+    // ChrIns -> HP chain -> HP block, one batched read per level for the whole step.
+    hpBlocks = characters;
+    for (uintptr_t offset : DS3Fields::CHARACTER_HP_CHAIN) {
+        reads.clear();
+        for (uintptr_t& address : hpBlocks) {
+            if (address != 0) {
+                reads.push_back({address + offset, &address, sizeof(address)});
+            }
+        }
+
+        ReadAll(source);
+        for (size_t i = 0; i < reads.size(); ++i) {
+            if (!readSucceeded[i]) {
+                *static_cast<uintptr_t*>(reads[i].buffer) = 0;
+            }
+        }
+    }
+
+    healths.assign(step, {});
+    reads.clear();
+    for (size_t i = 0; i < step; ++i) {
+        if (hpBlocks[i] != 0) {
+            reads.push_back({hpBlocks[i] + DS3Fields::CHARACTER_HP_OFFSET, &healths[i], sizeof(BossHealth)});
+        }
+    }
+    ReadAll(source);
+
+    for (size_t i = 0, read = 0; i < step; ++i) {
+        if (hpBlocks[i] == 0) {
+            continue;
+        }
+        if (!readSucceeded[read++]) {
+            continue;
+        }
+
+        uintptr_t hpAddress = hpBlocks[i] + DS3Fields::CHARACTER_HP_OFFSET;
+        const BossHealth& health = healths[i];
+        if (hpAddress == playerHpAddress || health.hp <= 0 || health.hp > health.maxHP ||
+            health.maxHP < MIN_BOSS_MAX_HP || health.maxHP <= candidate.maxHP) {
+            continue;
+        }
+
+        candidateHpAddress = hpAddress;
+        candidate = health;
+    }
+}
+
+template<MemorySource Source>
+std::optional<BossHealth> BossTracker::Poll(Source& source, uintptr_t listBegin, uintptr_t listEnd,
+    uintptr_t playerHpAddress) {
+    if (bossHpAddress != 0) {
+        ScopedReadTimer timer(hpMetric);
+
+        BossHealth health{};
+        if (source.ReadMemory(bossHpAddress, health) && health.maxHP == bossMaxHP) {
+            return health;
+        }
+
+        timer.SetSucceeded(false);
+        Reset();
+    }
+
+    size_t count = std::min((listEnd - listBegin) / sizeof(uintptr_t), MAX_CHARACTERS);
+    if (listBegin == 0 || count == 0) {
+        return std::nullopt;
+    }
+
+    if (cursor < count) {
+        ScanStep(source, listBegin, count, playerHpAddress);
+    }
+
+    if (cursor < count) {
+        return std::nullopt;
+    }
+
+    // A full pass is done: cache the best candidate, or start over on the next poll.
+    std::optional<BossHealth> found;
+    if (candidateHpAddress != 0) {
+        bossHpAddress = candidateHpAddress;
+        bossMaxHP = candidate.maxHP;
+        found = candidate;
+    }
+
+    cursor = 0;
+    candidateHpAddress = 0;
+    candidate = {};
+    return found;
+}
+
+uintptr_t BossTracker::GetHpAddress() const {
+    return bossHpAddress;
+}
+
+void BossTracker::Reset() {
+    bossHpAddress = 0;
+    bossMaxHP = 0;
+    cursor = 0;
+    candidateHpAddress = 0;
+    candidate = {};
+}
+
+template std::optional<BossHealth> BossTracker::Poll<MemoryReader>(MemoryReader&, uintptr_t, uintptr_t, uintptr_t);
+template std::optional<BossHealth> BossTracker::Poll<SnapshotMemorySource>(SnapshotMemorySource&, uintptr_t, uintptr_t, uintptr_t);
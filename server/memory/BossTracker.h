@@ -0,0 +1,61 @@
+#pragma once
+
+#include "MemorySource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+struct BossHealth {
+    int32_t hp;
+    int32_t maxHP;
+};
+
+// Finds the boss among the characters WorldChrMan has loaded and follows its HP. The list is
+// walked SCAN_STEP characters per Poll, so a search is spread over several samples; the boss
+// is the living character with the highest max HP, at least MIN_BOSS_MAX_HP. Once found, only
+// its HP block is read, until that read fails or its max HP changes (another character reused
+// the address), which starts a new search.
+class BossTracker {
+private:
+    static constexpr size_t SCAN_STEP = 64;
+    static constexpr size_t MAX_CHARACTERS = 4096;
+    static constexpr int32_t MIN_BOSS_MAX_HP = 1000;
+
+    // Address of the HP/max HP pair of the cached boss, 0 while searching.
+    uintptr_t bossHpAddress = 0;
+    int32_t bossMaxHP = 0;
+
+    size_t cursor = 0;
+    uintptr_t candidateHpAddress = 0;
+    BossHealth candidate{};
+
+    std::vector<uintptr_t> characters;
+    std::vector<uintptr_t> hpBlocks;
+    std::vector<BossHealth> healths;
+    std::vector<MemoryRead> reads;
+    std::vector<bool> readSucceeded;
+
+    size_t scanMetric = 0;
+    size_t hpMetric = 0;
+
+    template<MemorySource Source>
+    void ReadAll(Source& source);
+
+    template<MemorySource Source>
+    void ScanStep(Source& source, uintptr_t listBegin, size_t count, uintptr_t playerHpAddress);
+
+public:
+    BossTracker();
+
+    // Boss HP, or nullopt while the search is still running or found nothing. playerHpAddress
+    // keeps the player, who is in the list too, from being picked.
+    template<MemorySource Source>
+    std::optional<BossHealth> Poll(Source& source, uintptr_t listBegin, uintptr_t listEnd, uintptr_t playerHpAddress);
+
+    // Address of the boss's HP, followed by its max HP; 0 when no boss is cached.
+    uintptr_t GetHpAddress() const;
+
+    void Reset();
+};
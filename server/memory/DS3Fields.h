@@ -0,0 +1,90 @@
+#pragma once
+
+#include "PointerPath.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Every field DS3StatsReader samples, as a pointer path plus the value's offset and type.
+// Adding a field is one line here plus its entries in All and NAMES.
+namespace DS3Fields {
+    inline constexpr size_t CHARACTER_NAME_LENGTH = 24;
+
+    // Bytes of event-flag bitset read per poll, from the start of the EventFlags block.
+    inline constexpr size_t EVENT_FLAG_REGION_SIZE = 0x40000;
+
+    using GameDataMan = PointerPath<PathRoot::GameDataMan>;
+    using WorldChrMan = PointerPath<PathRoot::WorldChrMan>;
+    using Player = PointerPath<PathRoot::WorldChrMan, 0x80>;
+    using CharacterData = PointerPath<PathRoot::GameDataMan, 0x10>;
+    using PlayerHpStruct = PointerPath<PathRoot::WorldChrMan, 0x80, 0x1F90, 0x18>;
+    using PlayerPhysics = PointerPath<PathRoot::WorldChrMan, 0x80, 0x40, 0x28>;
+
+    // Inside any character instance (ChrIns), the HP block PlayerHpStruct reaches from the player.
+    inline constexpr std::array<uintptr_t, 2> CHARACTER_HP_CHAIN = {0x1F90, 0x18};
+    inline constexpr uintptr_t CHARACTER_HP_OFFSET = 0xD8;
+    inline constexpr uintptr_t CHARACTER_MAX_HP_OFFSET = 0xDC;
+
+    // Boss kills, bonfires and pickups; read as one block by EventFlagTracker, not through All.
+    using EventFlagMan = PointerPath<PathRoot::EventFlagMan>;
+    using EventFlags = PointerPath<PathRoot::EventFlagMan, 0x218>;
+
+    // Normal item slots of the inventory (EquipInventoryData), read as one block by
+    // InventoryTracker. Each slot is an InventorySlot; empty ones hold EMPTY_ITEM_ID.
+    using InventoryItems = PointerPath<PathRoot::GameDataMan, 0x10, 0x470, 0x10>;
+    inline constexpr size_t INVENTORY_SLOT_COUNT = 1920;
+    inline constexpr uint32_t EMPTY_ITEM_ID = 0xFFFFFFFF;
+
+    // Weapons (left and right, three each), ammunition, armor, rings and other equip slots.
+    inline constexpr size_t EQUIP_SLOT_COUNT = 20;
+
+    using DeathCount = PathField<GameDataMan, 0x98, uint32_t>;
+    using PlayTime = PathField<GameDataMan, 0xA4, uint32_t>;
+    using BossFight = PathField<GameDataMan, 0xC0, uint32_t>;
+
+    using Zone = PathField<Player, 0x1FE0, uint32_t>;
+    using PlayRegion = PathField<Player, 0x1ABC, uint32_t>;
+    using PlayerHP = PathField<PlayerHpStruct, CHARACTER_HP_OFFSET, int32_t>;
+    using PositionX = PathField<PlayerPhysics, 0x80, float>;
+    using PositionY = PathField<PlayerPhysics, 0x84, float>;
+    using PositionZ = PathField<PlayerPhysics, 0x88, float>;
+
+    // Characters loaded around the player: a [begin, end) array of ChrIns pointers.
+    using CharacterListBegin = PathField<WorldChrMan, 0x1F80, uint64_t>;
+    using CharacterListEnd = PathField<WorldChrMan, 0x1F88, uint64_t>;
+
+    using CharacterName = PathField<CharacterData, 0x88, char16_t[CHARACTER_NAME_LENGTH]>;
+    using CharacterClass = PathField<CharacterData, 0xAE, uint8_t>;
+    using Level = PathField<CharacterData, 0x70, uint32_t>;
+    using Souls = PathField<CharacterData, 0x74, uint32_t>;
+    using EquippedItems = PathField<CharacterData, 0x228, uint32_t[EQUIP_SLOT_COUNT]>;
+    using Vigor = PathField<CharacterData, 0x44, uint32_t>;
+    using Attunement = PathField<CharacterData, 0x48, uint32_t>;
+    using Endurance = PathField<CharacterData, 0x4C, uint32_t>;
+    using Vitality = PathField<CharacterData, 0x6C, uint32_t>;
+    using Strength = PathField<CharacterData, 0x50, uint32_t>;
+    using Dexterity = PathField<CharacterData, 0x54, uint32_t>;
+    using Intelligence = PathField<CharacterData, 0x58, uint32_t>;
+    using Faith = PathField<CharacterData, 0x5C, uint32_t>;
+    using Luck = PathField<CharacterData, 0x60, uint32_t>;
+
+    using All = FieldSet<
+        DeathCount, PlayTime, BossFight,
+        Zone, PlayRegion, PlayerHP,
+        PositionX, PositionY, PositionZ,
+        CharacterListBegin, CharacterListEnd,
+        CharacterName, CharacterClass, Level, Souls, EquippedItems,
+        Vigor, Attunement, Endurance, Vitality, Strength, Dexterity, Intelligence, Faith, Luck
+    >;
+
+    // Metric names, in All order.
+    inline constexpr std::array<const char*, All::count> NAMES = {
+        "deaths", "playtime", "bossFight",
+        "zone", "playRegion", "hp",
+        "positionX", "positionY", "positionZ",
+        "characterListBegin", "characterListEnd",
+        "name", "class", "level", "souls", "equippedItems",
+        "vigor", "attunement", "endurance", "vitality", "strength", "dexterity", "intelligence", "faith", "luck"
+    };
+}
@@ -1,192 +1,576 @@
 #include "DS3StatsReader.h"
+#include "SignatureCache.h"
+#include "SnapshotMemorySource.h"
+#include "../core/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+template<MemorySource Source>
+uintptr_t BasicDS3StatsReader<Source>::GetRootRva(PathRoot root) const {
+    switch (root) {
+        case PathRoot::GameDataMan: return gameDataManRva;
+        case PathRoot::WorldChrMan: return worldChrManRva;
+        case PathRoot::EventFlagMan: return eventFlagManRva;
+    }
+    return 0;
+}
 
-std::expected<uint32_t, MemoryReaderError> DS3StatsReader::ReadGameData(uintptr_t basePointer, uintptr_t offset) {
-    uintptr_t pointerAddress = reader.GetModuleBase() + basePointer;
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::ProbeRoots() {
+    ScopedReadTimer timer(probeMetric);
+    uintptr_t moduleBase = reader.GetModuleBase();
 
-    uintptr_t baseAddress = 0;
-    if (!reader.ReadMemory(pointerAddress, baseAddress)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    uintptr_t gameDataMan = 0;
+    uintptr_t worldChrMan = 0;
+    const MemoryRead roots[] = {
+        {moduleBase + GetRootRva(PathRoot::GameDataMan), &gameDataMan, sizeof(gameDataMan)},
+        {moduleBase + GetRootRva(PathRoot::WorldChrMan), &worldChrMan, sizeof(worldChrMan)},
+    };
+
+    if (!reader.ReadBatch(roots)) {
+        gameDataMan = 0;
+        worldChrMan = 0;
+        timer.SetSucceeded(false);
     }
 
-    if (baseAddress == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    // Read on its own so a stale EventFlagMan offset cannot fail the roots every field needs.
+    if (!reader.ReadMemory(moduleBase + GetRootRva(PathRoot::EventFlagMan), eventFlagMan)) {
+        eventFlagMan = 0;
     }
 
-    uintptr_t dataAddress = baseAddress + offset;
+    uintptr_t playerPtr = worldChrMan;
+    if (!DS3Fields::Player::Follow<0>(reader, playerPtr)) {
+        playerPtr = 0;
+    }
 
-    uint32_t value = 0;
-    if (!reader.ReadMemory(dataAddress, value)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    auto& gameDataEntry = chainCache[GAMEDATAMAN_CHAIN];
+    auto& worldChrEntry = chainCache[WORLDCHRMAN_CHAIN];
+    auto& playerEntry = chainCache[PLAYER_CHAIN];
+
+    if (gameDataEntry.address != gameDataMan || worldChrEntry.address != worldChrMan || playerEntry.address != playerPtr) {
+        ++generation;
     }
 
-    return value;
+    gameDataEntry = {gameDataMan, generation};
+    worldChrEntry = {worldChrMan, generation};
+    playerEntry = {playerPtr, generation};
+
+    GameState state = GameState::InGame;
+    if (gameDataMan == 0 || worldChrMan == 0) {
+        state = GameState::Loading;
+    } else if (playerPtr == 0) {
+        state = GameState::NoCharacter;
+    }
+
+    if (state != gameState) {
+        notReadyRetry = NOT_READY_RETRY_MIN;
+    }
+    gameState = state;
+
+    auto now = std::chrono::steady_clock::now();
+    if (state == GameState::InGame) {
+        nextRootProbe = now + ROOT_PROBE_INTERVAL;
+    } else {
+        nextRootProbe = now + notReadyRetry;
+        notReadyRetry = std::min(notReadyRetry * 2, NOT_READY_RETRY_MAX);
+    }
 }
 
-std::expected<void, MemoryReaderError> DS3StatsReader::Initialize() {
-    return reader.Initialize(PROCESS_NAME);
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::ProbeRootsIfDue() {
+    if (std::chrono::steady_clock::now() >= nextRootProbe) {
+        ProbeRoots();
+    }
 }
 
-bool DS3StatsReader::IsInitialized() const {
-    return reader.IsInitialized();
+// In game a failed read may mean the roots moved, so they are probed again right away.
+// Outside it failures are expected and the retry schedule stands.
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::InvalidateChains() {
+    ++generation;
+    if (gameState == GameState::InGame || gameState == GameState::Unknown) {
+        nextRootProbe = {};
+    }
 }
 
-bool DS3StatsReader::IsProcessRunning() const {
-    return reader.IsProcessRunning();
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::ResetGameState() {
+    gameState = GameState::Unknown;
+    notReadyRetry = NOT_READY_RETRY_MIN;
+    nextRootProbe = {};
 }
 
-void DS3StatsReader::Reset() {
-    reader.Reset();
+template<MemorySource Source>
+template<size_t I>
+uintptr_t BasicDS3StatsReader<Source>::FollowChain() {
+    constexpr size_t parent = Fields::parentOf<I>;
+    if constexpr (parent == CHAIN_COUNT) {
+        // Roots are only ever written by the probe.
+        return 0;
+    } else {
+        auto base = ResolveChain(parent);
+        if (!base) {
+            return 0;
+        }
+
+        uintptr_t address = *base;
+        if (!Fields::ChainAt<I>::template Follow<Fields::ChainAt<parent>::depth>(reader, address)) {
+            return 0;
+        }
+        return address;
+    }
 }
 
-std::expected<uint32_t, MemoryReaderError> DS3StatsReader::GetDeathCount() {
-    return ReadGameData(GAMEDATAMAN_POINTER, DEATH_COUNT_OFFSET);
+template<MemorySource Source>
+std::expected<uintptr_t, MemoryReaderError> BasicDS3StatsReader<Source>::ResolveChain(size_t chain) {
+    using ChainResolver = uintptr_t (BasicDS3StatsReader::*)();
+    static constexpr auto resolvers = []<size_t... I>(std::index_sequence<I...>) {
+        return std::array<ChainResolver, CHAIN_COUNT>{&BasicDS3StatsReader::FollowChain<I>...};
+    }(std::make_index_sequence<CHAIN_COUNT>{});
+
+    ProbeRootsIfDue();
+
+    auto& entry = chainCache[chain];
+    if (entry.generation != generation) {
+        if (chain == GAMEDATAMAN_CHAIN || chain == WORLDCHRMAN_CHAIN || chain == PLAYER_CHAIN) {
+            // Only the probe writes roots; until it is due again its last result stands.
+            entry.generation = generation;
+        } else {
+            ScopedReadTimer timer(chainMetrics[chain]);
+            entry = {(this->*resolvers[chain])(), generation};
+            timer.SetSucceeded(entry.address != 0);
+        }
+    }
+
+    if (entry.address == 0) {
+        return std::unexpected(GetReadError());
+    }
+
+    return entry.address;
 }
 
-std::expected<uint32_t, MemoryReaderError> DS3StatsReader::GetPlayTime() {
-    return ReadGameData(GAMEDATAMAN_POINTER, PLAYTIME_OFFSET);
+template<MemorySource Source>
+MemoryReaderError BasicDS3StatsReader<Source>::GetReadError() const {
+    return gameState == GameState::InGame ? MemoryReaderError::ReadFailed : MemoryReaderError::NotLoaded;
 }
 
-std::expected<uint32_t, MemoryReaderError> DS3StatsReader::ReadWorldChrData(uintptr_t offset) {
-    uintptr_t pointerAddress = reader.GetModuleBase() + WORLDCHRMAN_POINTER;
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::ExecutePlan(std::span<const size_t> fields, bool force) {
+    auto now = std::chrono::steady_clock::now();
+    auto blocks = plan.GetBlocks();
+
+    planReads.clear();
+    planReadBlocks.clear();
+
+    for (size_t field : fields) {
+        size_t block = plan.GetFieldBlock(field);
+        if (blockQueued[block] || (!force && now - blockReadAt[block] < PLAN_TTL)) {
+            continue;
+        }
+        blockQueued[block] = true;
+        blockReadAt[block] = now;
+        plan.SetBlockValid(block, false);
+
+        auto base = ResolveChain(blocks[block].chain);
+        if (!base) {
+            blockError[block] = base.error();
+            continue;
+        }
+
+        planReads.push_back({*base + blocks[block].offset, plan.GetBlockData(block), blocks[block].size});
+        planReadBlocks.push_back(block);
+    }
 
-    uintptr_t worldChrMan = 0;
-    if (!reader.ReadMemory(pointerAddress, worldChrMan)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    std::fill(blockQueued.begin(), blockQueued.end(), false);
+
+    if (planReads.empty()) {
+        return;
     }
 
-    if (worldChrMan == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    ScopedReadTimer timer(batchMetric);
+    if (!reader.ReadBatch(planReads)) {
+        timer.SetSucceeded(false);
+        for (size_t block : planReadBlocks) {
+            blockError[block] = GetReadError();
+        }
+        InvalidateChains();
+        return;
     }
 
-    uintptr_t playerPtr = 0;
-    if (!reader.ReadMemory(worldChrMan + WORLDCHRMAN_PLAYER_OFFSET, playerPtr)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    for (size_t block : planReadBlocks) {
+        plan.SetBlockValid(block, true);
+    }
+}
+
+template<MemorySource Source>
+std::expected<uintptr_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetRootAddress(PathRoot root) {
+    if (root == PathRoot::EventFlagMan) {
+        ProbeRootsIfDue();
+        if (eventFlagMan == 0) {
+            return std::unexpected(GetReadError());
+        }
+        return eventFlagMan;
+    }
+
+    return ResolveChain(root == PathRoot::GameDataMan ? GAMEDATAMAN_CHAIN : WORLDCHRMAN_CHAIN);
+}
+
+template<MemorySource Source>
+uint64_t BasicDS3StatsReader<Source>::GetGeneration() const {
+    return generation;
+}
+
+template<MemorySource Source>
+std::expected<uintptr_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetEventFlagRegion() {
+    auto root = GetRootAddress(PathRoot::EventFlagMan);
+    if (!root) {
+        return std::unexpected(root.error());
     }
 
-    if (playerPtr == 0) {
+    uintptr_t region = *root;
+    if (!DS3Fields::EventFlags::Follow<0>(reader, region)) {
         return std::unexpected(MemoryReaderError::ReadFailed);
     }
+    return region;
+}
+
+template<MemorySource Source>
+std::expected<uintptr_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetInventoryRegion() {
+    auto root = GetRootAddress(PathRoot::GameDataMan);
+    if (!root) {
+        return std::unexpected(root.error());
+    }
 
-    uint32_t value = 0;
-    if (!reader.ReadMemory(playerPtr + offset, value)) {
+    uintptr_t region = *root;
+    if (!DS3Fields::InventoryItems::Follow<0>(reader, region)) {
         return std::unexpected(MemoryReaderError::ReadFailed);
     }
+    return region;
+}
 
-    return value;
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::ExpirePlan() {
+    std::fill(blockReadAt.begin(), blockReadAt.end(), std::chrono::steady_clock::time_point{});
 }
 
-std::expected<uint32_t, MemoryReaderError> DS3StatsReader::GetCurrentZone() {
-    return ReadWorldChrData(PLAYER_ZONE_OFFSET);
+template<MemorySource Source>
+MemoryReaderError BasicDS3StatsReader<Source>::GetFieldError(size_t field) const {
+    return blockError[plan.GetFieldBlock(field)];
 }
 
-std::expected<uint32_t, MemoryReaderError> DS3StatsReader::GetPlayRegion() {
-    return ReadWorldChrData(PLAYER_PLAY_REGION_OFFSET);
+template<MemorySource Source>
+template<typename Field>
+std::expected<typename Field::Value, MemoryReaderError> BasicDS3StatsReader<Source>::ReadField() {
+    ScopedReadTimer timer(fieldMetrics[Fields::indexOf<Field>]);
+
+    const size_t fields[] = {Fields::indexOf<Field>};
+    ExecutePlan(fields, false);
+
+    typename Field::Value value{};
+    if (!plan.Decode(Fields::indexOf<Field>, value)) {
+        timer.SetSucceeded(false);
+        return std::unexpected(GetFieldError(Fields::indexOf<Field>));
+    }
+
+    return value;
 }
 
-std::expected<bool, MemoryReaderError> DS3StatsReader::GetInBossFight() {
-    auto result = ReadGameData(GAMEDATAMAN_POINTER, BOSS_FIGHT_OFFSET);
-    if (!result) {
-        return std::unexpected(result.error());
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::RegisterMetrics() {
+    for (size_t field = 0; field < Fields::count; ++field) {
+        fieldMetrics[field] = GetReadMetrics().Register(std::string("field:") + DS3Fields::NAMES[field]);
     }
-    return *result != 0;
+
+    [this]<size_t... I>(std::index_sequence<I...>) {
+        ((chainMetrics[I] = GetReadMetrics().Register("chain:" + Fields::ChainAt<I>::Describe())), ...);
+    }(std::make_index_sequence<CHAIN_COUNT>{});
+
+    statsMetric = GetReadMetrics().Register("field:stats");
+    probeMetric = GetReadMetrics().Register("probe");
+    batchMetric = GetReadMetrics().Register("batch");
 }
 
-std::expected<int32_t, MemoryReaderError> DS3StatsReader::GetPlayerHP() {
-    uintptr_t pointerAddress = reader.GetModuleBase() + WORLDCHRMAN_POINTER;
+template<MemorySource Source>
+BasicDS3StatsReader<Source>::BasicDS3StatsReader() {
+    RegisterMetrics();
 
-    uintptr_t worldChrMan = 0;
-    if (!reader.ReadMemory(pointerAddress, worldChrMan) || worldChrMan == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    // Registered in FieldSet order, so a field's plan index is Fields::indexOf<Field>.
+    for (const FieldSpec& spec : Fields::specs) {
+        plan.AddField(spec.chain, spec.offset, spec.size);
     }
 
-    uintptr_t playerPtr = 0;
-    if (!reader.ReadMemory(worldChrMan + WORLDCHRMAN_PLAYER_OFFSET, playerPtr) || playerPtr == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    plan.Compile();
+    blockQueued.assign(plan.GetBlocks().size(), false);
+    blockReadAt.assign(plan.GetBlocks().size(), {});
+    blockError.assign(plan.GetBlocks().size(), MemoryReaderError::ReadFailed);
+}
+
+template<MemorySource Source>
+Source& BasicDS3StatsReader<Source>::GetSource() {
+    return reader;
+}
+
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::ResolveRoots() {
+    gameDataManRva = GameBuilds::FALLBACK.gameDataMan;
+    worldChrManRva = GameBuilds::FALLBACK.worldChrMan;
+    eventFlagManRva = GameBuilds::FALLBACK.eventFlagMan;
+    buildTimestamp = std::nullopt;
+
+    uintptr_t moduleBase = reader.GetModuleBase();
+    size_t moduleSize = reader.GetModuleSize();
+    if (moduleSize < MODULE_HEADER_SIZE || moduleSize > MAX_SCAN_SIZE) {
+        return;
     }
 
-    uintptr_t playerData = 0;
-    if (!reader.ReadMemory(playerPtr + PLAYER_DATA_OFFSET, playerData) || playerData == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    std::vector<uint8_t> header(MODULE_HEADER_SIZE);
+    const MemoryRead headerRead[] = {{moduleBase, header.data(), header.size()}};
+    if (!reader.ReadBatch(headerRead)) {
+        return;
     }
 
-    uintptr_t hpStruct = 0;
-    if (!reader.ReadMemory(playerData + PLAYER_HP_STRUCT_OFFSET, hpStruct) || hpStruct == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    buildTimestamp = SignatureScanner::ReadPeTimestamp(header);
+
+    uint64_t moduleHash = SignatureScanner::HashModuleHeader(header);
+    if (auto cached = g_signatureCache.Find(moduleHash)) {
+        gameDataManRva = cached->gameDataMan;
+        worldChrManRva = cached->worldChrMan;
+        eventFlagManRva = cached->eventFlagMan != 0 ? cached->eventFlagMan : GameBuilds::FALLBACK.eventFlagMan;
+        return;
     }
 
-    int32_t hp = 0;
-    if (!reader.ReadMemory(hpStruct + PLAYER_HP_OFFSET, hp)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    // Unreadable pages (guard pages, discarded sections) are left zeroed rather than failing the scan.
+    std::vector<uint8_t> image(moduleSize);
+    for (size_t offset = 0; offset < moduleSize; offset += SCAN_CHUNK_SIZE) {
+        size_t chunkSize = std::min(SCAN_CHUNK_SIZE, moduleSize - offset);
+        const MemoryRead chunk[] = {{moduleBase + offset, image.data() + offset, chunkSize}};
+        reader.ReadBatch(chunk);
+    }
+
+    auto gameDataMan = SignatureScanner::ResolveRipRelative(image, GAMEDATAMAN_SIGNATURE);
+    auto worldChrMan = SignatureScanner::ResolveRipRelative(image, WORLDCHRMAN_SIGNATURE);
+    if (!gameDataMan || !worldChrMan) {
+        log(LogLevel::WARN, "Signature scan failed, using built-in offsets");
+        return;
+    }
+
+    // Event flags are optional: without them only flag diffs are lost, so the built-in offset is kept.
+    auto eventFlagManScan = SignatureScanner::ResolveRipRelative(image, EVENTFLAGMAN_SIGNATURE);
+    if (!eventFlagManScan) {
+        log(LogLevel::WARN, "EventFlagMan signature not found, using built-in offset");
     }
 
-    return hp;
+    gameDataManRva = *gameDataMan;
+    worldChrManRva = *worldChrMan;
+    eventFlagManRva = eventFlagManScan.value_or(GameBuilds::FALLBACK.eventFlagMan);
+    g_signatureCache.Store(moduleHash, {gameDataManRva, worldChrManRva, eventFlagManScan.value_or(0)});
+
+    char roots[160];
+    std::snprintf(roots, sizeof(roots), "Resolved game roots by signature scan "
+        "(PE timestamp 0x%08X): GameDataMan 0x%llX, WorldChrMan 0x%llX, EventFlagMan 0x%llX",
+        buildTimestamp.value_or(0), static_cast<unsigned long long>(gameDataManRva),
+        static_cast<unsigned long long>(worldChrManRva), static_cast<unsigned long long>(eventFlagManRva));
+    log(LogLevel::INFO, roots);
 }
 
-std::expected<uintptr_t, MemoryReaderError> DS3StatsReader::GetCharacterDataBase() {
-    uintptr_t pointerAddress = reader.GetModuleBase() + GAMEDATAMAN_POINTER;
+template<MemorySource Source>
+std::expected<void, MemoryReaderError> BasicDS3StatsReader<Source>::Initialize() {
+    ResetGameState();
+    InvalidateChains();
+    ExpirePlan();
 
-    uintptr_t gameDataMan = 0;
-    if (!reader.ReadMemory(pointerAddress, gameDataMan) || gameDataMan == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    auto result = reader.Initialize(PROCESS_NAME);
+    if (result) {
+        ResolveRoots();
     }
+    return result;
+}
 
-    uintptr_t characterData = 0;
-    if (!reader.ReadMemory(gameDataMan + CHARACTER_DATA_OFFSET, characterData) || characterData == 0) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+template<MemorySource Source>
+GameState BasicDS3StatsReader<Source>::GetGameState() {
+    if (!reader.IsInitialized()) {
+        return GameState::Unknown;
     }
 
-    return characterData;
+    ProbeRootsIfDue();
+    return gameState;
 }
 
-std::expected<std::wstring, MemoryReaderError> DS3StatsReader::GetCharacterName() {
-    auto baseResult = GetCharacterDataBase();
-    if (!baseResult) {
-        return std::unexpected(baseResult.error());
-    }
+template<MemorySource Source>
+std::optional<uint32_t> BasicDS3StatsReader<Source>::GetBuildTimestamp() const {
+    return buildTimestamp;
+}
 
-    wchar_t nameBuffer[24] = {0};
-    if (!reader.ReadMemory(*baseResult + CHARACTER_NAME_OFFSET, nameBuffer)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+template<MemorySource Source>
+bool BasicDS3StatsReader<Source>::IsInitialized() const {
+    return reader.IsInitialized();
+}
+
+template<MemorySource Source>
+bool BasicDS3StatsReader<Source>::IsProcessRunning() const {
+    return reader.IsProcessRunning();
+}
+
+template<MemorySource Source>
+void BasicDS3StatsReader<Source>::Reset() {
+    ResetGameState();
+    InvalidateChains();
+    ExpirePlan();
+    reader.Reset();
+}
+
+template<MemorySource Source>
+std::expected<uint32_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetDeathCount() {
+    return ReadField<DS3Fields::DeathCount>();
+}
+
+template<MemorySource Source>
+std::expected<uint32_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetPlayTime() {
+    return ReadField<DS3Fields::PlayTime>();
+}
+
+template<MemorySource Source>
+std::expected<uint32_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetCurrentZone() {
+    return ReadField<DS3Fields::Zone>();
+}
+
+template<MemorySource Source>
+std::expected<uint32_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetPlayRegion() {
+    return ReadField<DS3Fields::PlayRegion>();
+}
+
+template<MemorySource Source>
+std::expected<bool, MemoryReaderError> BasicDS3StatsReader<Source>::GetInBossFight() {
+    auto result = ReadField<DS3Fields::BossFight>();
+    if (!result) {
+        return std::unexpected(result.error());
     }
+    return *result != 0;
+}
 
-    return std::wstring(nameBuffer);
+template<MemorySource Source>
+std::expected<int32_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetPlayerHP() {
+    return ReadField<DS3Fields::PlayerHP>();
 }
 
-std::expected<uint8_t, MemoryReaderError> DS3StatsReader::GetClass() {
-    auto baseResult = GetCharacterDataBase();
-    if (!baseResult) {
-        return std::unexpected(baseResult.error());
+template<MemorySource Source>
+std::expected<PlayerPosition, MemoryReaderError> BasicDS3StatsReader<Source>::GetPlayerPosition() {
+    const size_t fields[] = {
+        Fields::indexOf<DS3Fields::PositionX>, Fields::indexOf<DS3Fields::PositionY>, Fields::indexOf<DS3Fields::PositionZ>
+    };
+    ExecutePlan(fields, false);
+
+    PlayerPosition position{};
+    if (!plan.Decode(Fields::indexOf<DS3Fields::PositionX>, position.x) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::PositionY>, position.y) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::PositionZ>, position.z)) {
+        return std::unexpected(GetFieldError(Fields::indexOf<DS3Fields::PositionX>));
     }
 
-    uint8_t classId = 0;
-    if (!reader.ReadMemory(*baseResult + CHARACTER_CLASS_OFFSET, classId)) {
+    return position;
+}
+
+template<MemorySource Source>
+std::expected<CharacterList, MemoryReaderError> BasicDS3StatsReader<Source>::GetCharacterList() {
+    auto begin = ReadField<DS3Fields::CharacterListBegin>();
+    auto end = ReadField<DS3Fields::CharacterListEnd>();
+    if (!begin) {
+        return std::unexpected(begin.error());
+    }
+    if (!end) {
+        return std::unexpected(end.error());
+    }
+    if (*begin == 0 || *end < *begin) {
         return std::unexpected(MemoryReaderError::ReadFailed);
     }
+    return CharacterList{static_cast<uintptr_t>(*begin), static_cast<uintptr_t>(*end)};
+}
+
+template<MemorySource Source>
+std::expected<std::wstring, MemoryReaderError> BasicDS3StatsReader<Source>::GetCharacterName() {
+    ScopedReadTimer timer(fieldMetrics[Fields::indexOf<DS3Fields::CharacterName>]);
+
+    const size_t fields[] = {Fields::indexOf<DS3Fields::CharacterName>};
+    ExecutePlan(fields, false);
+
+    // The game stores names as UTF-16 regardless of the host's wchar_t width.
+    DS3Fields::CharacterName::Value nameBuffer = {0};
+    if (!plan.Decode(Fields::indexOf<DS3Fields::CharacterName>, nameBuffer)) {
+        timer.SetSucceeded(false);
+        return std::unexpected(GetFieldError(Fields::indexOf<DS3Fields::CharacterName>));
+    }
+
+    std::wstring name;
+    for (char16_t c : nameBuffer) {
+        if (c == u'\0') {
+            break;
+        }
+        name.push_back(static_cast<wchar_t>(c));
+    }
 
-    return classId;
+    return name;
 }
 
-std::expected<CharacterStats, MemoryReaderError> DS3StatsReader::GetCharacterStats() {
-	auto baseResult = GetCharacterDataBase();
-    if (!baseResult) {
-        return std::unexpected(baseResult.error());
-	}
+template<MemorySource Source>
+std::expected<uint8_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetClass() {
+    return ReadField<DS3Fields::CharacterClass>();
+}
 
-	uintptr_t base = *baseResult;
-    CharacterStats statsRecord{};
+template<MemorySource Source>
+std::expected<CharacterStats, MemoryReaderError> BasicDS3StatsReader<Source>::GetCharacterStats() {
+    ScopedReadTimer timer(statsMetric);
 
-    if (!reader.ReadMemory(base + CHARACTER_LEVEL_OFFSET, statsRecord.level) ||
-        !reader.ReadMemory(base + STAT_VIGOR_OFFSET, statsRecord.vigor) ||
-        !reader.ReadMemory(base + STAT_ATTUNEMENT_OFFSET, statsRecord.attunement) ||
-        !reader.ReadMemory(base + STAT_ENDURANCE_OFFSET, statsRecord.endurance) ||
-        !reader.ReadMemory(base + STAT_VITALITY_OFFSET, statsRecord.vitality) ||
-        !reader.ReadMemory(base + STAT_STRENGTH_OFFSET, statsRecord.strength) ||
-        !reader.ReadMemory(base + STAT_DEXTERITY_OFFSET, statsRecord.dexterity) ||
-        !reader.ReadMemory(base + STAT_INTELLIGENCE_OFFSET, statsRecord.intelligence) ||
-        !reader.ReadMemory(base + STAT_FAITH_OFFSET, statsRecord.faith) ||
-        !reader.ReadMemory(base + STAT_LUCK_OFFSET, statsRecord.luck)) {
-        return std::unexpected(MemoryReaderError::ReadFailed);
+    const size_t fields[] = {
+        Fields::indexOf<DS3Fields::Level>, Fields::indexOf<DS3Fields::Vigor>,
+        Fields::indexOf<DS3Fields::Attunement>, Fields::indexOf<DS3Fields::Endurance>,
+        Fields::indexOf<DS3Fields::Vitality>, Fields::indexOf<DS3Fields::Strength>,
+        Fields::indexOf<DS3Fields::Dexterity>, Fields::indexOf<DS3Fields::Intelligence>,
+        Fields::indexOf<DS3Fields::Faith>, Fields::indexOf<DS3Fields::Luck>
+    };
+    ExecutePlan(fields, false);
+
+    CharacterStats statsRecord{};
+    if (!plan.Decode(Fields::indexOf<DS3Fields::Level>, statsRecord.level) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Vigor>, statsRecord.vigor) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Attunement>, statsRecord.attunement) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Endurance>, statsRecord.endurance) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Vitality>, statsRecord.vitality) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Strength>, statsRecord.strength) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Dexterity>, statsRecord.dexterity) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Intelligence>, statsRecord.intelligence) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Faith>, statsRecord.faith) ||
+        !plan.Decode(Fields::indexOf<DS3Fields::Luck>, statsRecord.luck)) {
+        timer.SetSucceeded(false);
+        return std::unexpected(GetFieldError(Fields::indexOf<DS3Fields::Level>));
     }
 
     return statsRecord;
 }
+
+template<MemorySource Source>
+std::expected<uint32_t, MemoryReaderError> BasicDS3StatsReader<Source>::GetSouls() {
+    return ReadField<DS3Fields::Souls>();
+}
+
+template<MemorySource Source>
+std::expected<EquippedItems, MemoryReaderError> BasicDS3StatsReader<Source>::GetEquippedItems() {
+    ScopedReadTimer timer(fieldMetrics[Fields::indexOf<DS3Fields::EquippedItems>]);
+
+    const size_t fields[] = {Fields::indexOf<DS3Fields::EquippedItems>};
+    ExecutePlan(fields, false);
+
+    DS3Fields::EquippedItems::Value slots = {0};
+    if (!plan.Decode(Fields::indexOf<DS3Fields::EquippedItems>, slots)) {
+        timer.SetSucceeded(false);
+        return std::unexpected(GetFieldError(Fields::indexOf<DS3Fields::EquippedItems>));
+    }
+
+    EquippedItems items{};
+    std::copy(std::begin(slots), std::end(slots), items.begin());
+    return items;
+}
+
+template class BasicDS3StatsReader<MemoryReader>;
+template class BasicDS3StatsReader<SnapshotMemorySource>;
@@ -1,10 +1,21 @@
 #pragma once
 
+#include "DS3Fields.h"
+#include "GameBuilds.h"
+#include "GameState.h"
 #include "MemoryReader.h"
+#include "ReadMetrics.h"
+#include "ReadPlan.h"
+#include "SignatureScanner.h"
 
+#include <array>
+#include <chrono>
 #include <expected>
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 struct CharacterStats {
     uint32_t level;
@@ -19,59 +30,195 @@ struct CharacterStats {
 	uint32_t luck;
 };
 
-class DS3StatsReader {
+// Player world coordinates, in metres.
+struct PlayerPosition {
+    float x;
+    float y;
+    float z;
+};
+
+// [begin, end) of the loaded characters' ChrIns pointer array.
+struct CharacterList {
+    uintptr_t begin;
+    uintptr_t end;
+};
+
+// Item id in each equip slot, DS3Fields::EMPTY_ITEM_ID for an empty one.
+using EquippedItems = std::array<uint32_t, DS3Fields::EQUIP_SLOT_COUNT>;
+
+template<MemorySource Source>
+class BasicDS3StatsReader {
 private:
-    MemoryReader reader;
-
-    static constexpr uintptr_t GAMEDATAMAN_POINTER = 0x047572B8;
-    static constexpr uintptr_t DEATH_COUNT_OFFSET = 0x98;
-    static constexpr uintptr_t PLAYTIME_OFFSET = 0xA4;
-
-    static constexpr uintptr_t WORLDCHRMAN_POINTER = 0x0477FDB8;
-    static constexpr uintptr_t WORLDCHRMAN_PLAYER_OFFSET = 0x80;
-    static constexpr uintptr_t PLAYER_ZONE_OFFSET = 0x1FE0;
-    static constexpr uintptr_t PLAYER_PLAY_REGION_OFFSET = 0x1ABC;
-
-    static constexpr uintptr_t BOSS_FIGHT_OFFSET = 0xC0;
-
-    static constexpr uintptr_t PLAYER_DATA_OFFSET = 0x1F90;
-    static constexpr uintptr_t PLAYER_HP_STRUCT_OFFSET = 0x18;
-    static constexpr uintptr_t PLAYER_HP_OFFSET = 0xD8;
-
-    static constexpr uintptr_t CHARACTER_DATA_OFFSET = 0x10;
-    static constexpr uintptr_t CHARACTER_NAME_OFFSET = 0x88;
-    static constexpr uintptr_t CHARACTER_LEVEL_OFFSET = 0x70;
-    static constexpr uintptr_t CHARACTER_CLASS_OFFSET = 0xAE;
-
-	static constexpr uintptr_t STAT_VIGOR_OFFSET = 0x44;
-    static constexpr uintptr_t STAT_ATTUNEMENT_OFFSET = 0x48;
-    static constexpr uintptr_t STAT_ENDURANCE_OFFSET = 0x4C;
-    static constexpr uintptr_t STAT_VITALITY_OFFSET = 0x6C;
-    static constexpr uintptr_t STAT_STRENGTH_OFFSET = 0x50;
-    static constexpr uintptr_t STAT_DEXTERITY_OFFSET = 0x54;
-    static constexpr uintptr_t STAT_INTELLIGENCE_OFFSET = 0x58;
-    static constexpr uintptr_t STAT_FAITH_OFFSET = 0x5C;
-    static constexpr uintptr_t STAT_LUCK_OFFSET = 0x60;
+    Source reader;
 
-    static constexpr wchar_t PROCESS_NAME[] = L"DarkSoulsIII.exe";
+    // Paths, offsets and value types of every sampled field live in DS3Fields.h.
+    using Fields = DS3Fields::All;
+    static constexpr size_t CHAIN_COUNT = Fields::Chains::size;
+
+    // Roots are located by signature, with results cached per module hash in SignatureCache,
+    // and fall back to GameBuilds::FALLBACK when a scan fails.
+    static constexpr RipRelativeSignature GAMEDATAMAN_SIGNATURE = {
+        "48 8B 05 ?? ?? ?? ?? 48 85 C0 ?? ?? 48 8B 40 ?? C3", 3, 7
+    };
+    static constexpr RipRelativeSignature WORLDCHRMAN_SIGNATURE = {
+        "48 8B 1D ?? ?? ?? 04 48 8B F9 48 85 DB ?? ?? 8B 11 85 D2 ?? ?? 8D", 3, 7
+    };
+    static constexpr RipRelativeSignature EVENTFLAGMAN_SIGNATURE = {
+        "48 C7 05 ?? ?? ?? ?? 00 00 00 00 48 8B 7C 24 38 C7 46 54 FF FF FF FF 48 83 C4 20 5E C3", 3, 11
+    };
+
+    static constexpr size_t MODULE_HEADER_SIZE = 0x1000;
+    static constexpr size_t MAX_SCAN_SIZE = 256 * 1024 * 1024;
+    static constexpr size_t SCAN_CHUNK_SIZE = 1024 * 1024;
+
+    uintptr_t gameDataManRva = GameBuilds::FALLBACK.gameDataMan;
+    uintptr_t worldChrManRva = GameBuilds::FALLBACK.worldChrMan;
+    uintptr_t eventFlagManRva = GameBuilds::FALLBACK.eventFlagMan;
+
+    // Set on attach from the module's PE header.
+    std::optional<uint32_t> buildTimestamp;
+
+    void ResolveRoots();
+    uintptr_t GetRootRva(PathRoot root) const;
+
+    // Resolved chain pointers stay valid while the generation they were resolved in is current.
+    // The generation is bumped whenever the root probe sees GameDataMan, WorldChrMan or the
+    // player instance move (load screens, character switches) or a cached read fails.
+    static constexpr auto ROOT_PROBE_INTERVAL = std::chrono::milliseconds(250);
+
+    // Outside the game the probe is what notices the game coming back, so it is retried on
+    // a delay that doubles from NOT_READY_RETRY_MIN to NOT_READY_RETRY_MAX. Until then the
+    // chains behind the null pointer fail from the cache, without reading anything.
+    static constexpr auto NOT_READY_RETRY_MIN = std::chrono::milliseconds(100);
+    static constexpr auto NOT_READY_RETRY_MAX = std::chrono::milliseconds(1000);
+
+    struct CachedPointer {
+        uintptr_t address = 0;
+        uint64_t generation = 0;
+    };
+
+    static constexpr size_t GAMEDATAMAN_CHAIN = Fields::chainIndexOf<DS3Fields::GameDataMan>;
+    static constexpr size_t WORLDCHRMAN_CHAIN = Fields::chainIndexOf<DS3Fields::WorldChrMan>;
+    static constexpr size_t PLAYER_CHAIN = Fields::chainIndexOf<DS3Fields::Player>;
+    static_assert(PLAYER_CHAIN < CHAIN_COUNT, "the root probe watches the player instance");
+
+    std::array<CachedPointer, CHAIN_COUNT> chainCache{};
+    uint64_t generation = 1;
+    std::chrono::steady_clock::time_point nextRootProbe{};
+    GameState gameState = GameState::Unknown;
+    std::chrono::milliseconds notReadyRetry = NOT_READY_RETRY_MIN;
+
+    // No sampled field hangs off EventFlagMan, so it has no chain; the probe keeps it here.
+    uintptr_t eventFlagMan = 0;
+
+    void ProbeRoots();
+    void ProbeRootsIfDue();
+    void InvalidateChains();
+    void ResetGameState();
+    std::expected<uintptr_t, MemoryReaderError> ResolveChain(size_t chain);
+
+    // Resolves chain I from the longest chain prefixing it, one instantiation per chain.
+    template<size_t I>
+    uintptr_t FollowChain();
+
+    // Every field is fetched through one compiled plan of coalesced blocks. Only the blocks
+    // holding the requested fields are read, and a block read within PLAN_TTL is reused, so a
+    // burst of getter calls shares one batched read.
+    static constexpr auto PLAN_TTL = std::chrono::milliseconds(10);
+
+    ReadPlan plan;
+    std::vector<MemoryRead> planReads;
+    std::vector<size_t> planReadBlocks;
+    std::vector<bool> blockQueued;
+    std::vector<std::chrono::steady_clock::time_point> blockReadAt;
 
-    std::expected<uint32_t, MemoryReaderError> ReadGameData(uintptr_t basePointer, uintptr_t offset);
-    std::expected<uint32_t, MemoryReaderError> ReadWorldChrData(uintptr_t offset);
-    std::expected<uintptr_t, MemoryReaderError> GetCharacterDataBase();
+    // Why each block is invalid: its chain's error, or ReadFailed for a failed batch.
+    std::vector<MemoryReaderError> blockError;
+
+    void ExecutePlan(std::span<const size_t> fields, bool force);
+    void ExpirePlan();
+
+    // The error a read of the field failed with when its block was last read.
+    MemoryReaderError GetFieldError(size_t field) const;
+
+    // What a failed read means: NotLoaded while the probe sees the game outside InGame.
+    MemoryReaderError GetReadError() const;
+
+    template<typename Field>
+    std::expected<typename Field::Value, MemoryReaderError> ReadField();
+
+    // GetReadMetrics() keys: one per field, per chain, plus the stats getter, root probe and plan batch.
+    std::array<size_t, Fields::count> fieldMetrics{};
+    std::array<size_t, CHAIN_COUNT> chainMetrics{};
+    size_t statsMetric = 0;
+    size_t probeMetric = 0;
+    size_t batchMetric = 0;
+
+    void RegisterMetrics();
 
 public:
+    static constexpr wchar_t PROCESS_NAME[] = L"DarkSoulsIII.exe";
+
+    BasicDS3StatsReader();
+
+    Source& GetSource();
+
+    // Re-reads the blocks holding the given fields in one batch, regardless of PLAN_TTL.
+    template<typename... RefreshFields>
+    void Refresh() {
+        const size_t fields[] = {Fields::indexOf<RefreshFields>...};
+        ExecutePlan(fields, true);
+    }
+
+    // Probes the roots if due and reports what they show. Reads of fields behind a missing
+    // pointer fail with MemoryReaderError::NotLoaded until this reports InGame again.
+    GameState GetGameState();
+
+    // Current root pointer, as seen by the last root probe.
+    std::expected<uintptr_t, MemoryReaderError> GetRootAddress(PathRoot root);
+
+    // Start of the event-flag bitset, DS3Fields::EVENT_FLAG_REGION_SIZE bytes long.
+    std::expected<uintptr_t, MemoryReaderError> GetEventFlagRegion();
+
+    // First normal item slot, DS3Fields::INVENTORY_SLOT_COUNT InventorySlots long.
+    std::expected<uintptr_t, MemoryReaderError> GetInventoryRegion();
+
+    // Bumped whenever cached chains are dropped; an address from GetFieldAddress is only good
+    // while it stands.
+    uint64_t GetGeneration() const;
+
+    // Address of a field in the game, through the cached chain. Valid until the next load screen.
+    template<typename Field>
+    std::expected<uintptr_t, MemoryReaderError> GetFieldAddress() {
+        auto base = ResolveChain(Fields::chainIndexOf<typename Field::Chain>);
+        if (!base) {
+            return std::unexpected(base.error());
+        }
+        return *base + Field::offset;
+    }
+
     std::expected<void, MemoryReaderError> Initialize();
     bool IsInitialized() const;
+
+    // TimeDateStamp of the attached module's PE header, which tells builds apart.
+    std::optional<uint32_t> GetBuildTimestamp() const;
     bool IsProcessRunning() const;
     void Reset();
+
     std::expected<uint32_t, MemoryReaderError> GetDeathCount();
     std::expected<uint32_t, MemoryReaderError> GetPlayTime();
     std::expected<uint32_t, MemoryReaderError> GetCurrentZone();
     std::expected<uint32_t, MemoryReaderError> GetPlayRegion();
     std::expected<bool, MemoryReaderError> GetInBossFight();
     std::expected<int32_t, MemoryReaderError> GetPlayerHP();
+    std::expected<PlayerPosition, MemoryReaderError> GetPlayerPosition();
+    std::expected<CharacterList, MemoryReaderError> GetCharacterList();
 
     std::expected<std::wstring, MemoryReaderError> GetCharacterName();
     std::expected<uint8_t, MemoryReaderError> GetClass();
 	std::expected<CharacterStats, MemoryReaderError> GetCharacterStats();
+    std::expected<uint32_t, MemoryReaderError> GetSouls();
+    std::expected<EquippedItems, MemoryReaderError> GetEquippedItems();
 };
+
+using DS3StatsReader = BasicDS3StatsReader<MemoryReader>;
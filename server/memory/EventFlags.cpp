@@ -0,0 +1,78 @@
+#include "EventFlags.h"
+#include "BlockDiff.h"
+#include "DS3Fields.h"
+#include "MemoryReader.h"
+#include "ReadMetrics.h"
+#include "SnapshotMemorySource.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace {
+    constexpr size_t WORD_BITS = 32;
+
+    void DiffWords(const uint8_t* previous, const uint8_t* current, size_t byteOffset, size_t byteCount,
+        std::vector<EventFlagChange>& changes) {
+        for (size_t offset = 0; offset + sizeof(uint32_t) <= byteCount; offset += sizeof(uint32_t)) {
+            uint32_t before;
+            uint32_t after;
+            std::memcpy(&before, previous + offset, sizeof(before));
+            std::memcpy(&after, current + offset, sizeof(after));
+
+            uint32_t differing = before ^ after;
+            while (differing) {
+                uint32_t fromTop = static_cast<uint32_t>(std::countl_zero(differing));
+                uint32_t bit = 0x80000000u >> fromTop;
+                uint32_t word = static_cast<uint32_t>((byteOffset + offset) / sizeof(uint32_t));
+                changes.push_back({word * static_cast<uint32_t>(WORD_BITS) + fromTop, (after & bit) != 0});
+                differing &= ~bit;
+            }
+        }
+    }
+}
+
+namespace EventFlagDiff {
+    void Diff(std::span<const uint8_t> previous, std::span<const uint8_t> current, std::vector<EventFlagChange>& changes) {
+        size_t size = std::min(previous.size(), current.size());
+
+        // Allocates only when something changed.
+        std::vector<uint32_t> spans;
+        BlockDiff::ChangedSpans(previous, current, spans);
+
+        for (uint32_t offset : spans) {
+            DiffWords(previous.data() + offset, current.data() + offset, offset,
+                std::min(BlockDiff::SPAN_SIZE, size - offset), changes);
+        }
+    }
+}
+
+EventFlagTracker::EventFlagTracker()
+    : previous(DS3Fields::EVENT_FLAG_REGION_SIZE), current(DS3Fields::EVENT_FLAG_REGION_SIZE),
+      readMetric(GetReadMetrics().Register("eventFlags")) {}
+
+template<MemorySource Source>
+bool EventFlagTracker::Poll(Source& source, uintptr_t region, std::vector<EventFlagChange>& changes) {
+    ScopedReadTimer timer(readMetric);
+
+    const MemoryRead read[] = {{region, current.data(), current.size()}};
+    if (region == 0 || !source.ReadBatch(read)) {
+        timer.SetSucceeded(false);
+        return false;
+    }
+
+    if (hasBaseline) {
+        EventFlagDiff::Diff(previous, current, changes);
+    }
+
+    previous.swap(current);
+    hasBaseline = true;
+    return true;
+}
+
+void EventFlagTracker::Reset() {
+    hasBaseline = false;
+}
+
+template bool EventFlagTracker::Poll<MemoryReader>(MemoryReader&, uintptr_t, std::vector<EventFlagChange>&);
+template bool EventFlagTracker::Poll<SnapshotMemorySource>(SnapshotMemorySource&, uintptr_t, std::vector<EventFlagChange>&);
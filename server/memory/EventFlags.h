@@ -0,0 +1,40 @@
+#pragma once
+
+#include "MemorySource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// A flag is its bit position in the region: 32-bit little-endian words with the highest bit
+// first, the order the game packs them in. Ids are region offsets, not the game's flag ids.
+struct EventFlagChange {
+    uint32_t flag;
+    bool set;
+};
+
+namespace EventFlagDiff {
+    // Appends every flag that differs between two equally sized snapshots, in ascending order.
+    // Only the spans BlockDiff reports as changed are decoded, so a quiet region is diffed at
+    // about memcmp speed.
+    void Diff(std::span<const uint8_t> previous, std::span<const uint8_t> current, std::vector<EventFlagChange>& changes);
+}
+
+// Reads the whole flag region in one block per poll and reports what changed since the
+// previous poll. The first poll after construction or Reset only records a baseline.
+class EventFlagTracker {
+private:
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> current;
+    bool hasBaseline = false;
+    size_t readMetric = 0;
+
+public:
+    EventFlagTracker();
+
+    template<MemorySource Source>
+    bool Poll(Source& source, uintptr_t region, std::vector<EventFlagChange>& changes);
+
+    void Reset();
+};
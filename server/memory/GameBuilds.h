@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GameBuilds {
+    // Root RVAs of one DarkSoulsIII.exe build. The structures behind the roots are laid out
+    // alike across the patched builds, so the offsets in DS3Fields serve all of them and a build
+    // only differs in where its roots live.
+    struct Roots {
+        uintptr_t gameDataMan;
+        uintptr_t worldChrMan;
+        uintptr_t eventFlagMan;
+    };
+
+    // The 1.15 build's roots, used when the signature scan finds nothing. Builds are not
+    // recognised by PE timestamp: no build's stamp has been checked against its executable, and
+    // a wrong one would skip the scan with the wrong roots.
+    inline constexpr Roots FALLBACK = {0x047572B8, 0x0477FDB8, 0x0473BE28};
+}
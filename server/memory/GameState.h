@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+// What the root probe last found behind the pointers every field hangs off.
+enum class GameState : uint8_t {
+    Unknown,        // not probed since attaching
+    Loading,        // GameDataMan or WorldChrMan unreadable or null: boot and load screens
+    NoCharacter,    // roots set but no player instance: title screen, character select
+    InGame
+};
+
+inline const char* gameStateToString(GameState state) {
+    switch (state) {
+        case GameState::Unknown: return "unknown";
+        case GameState::Loading: return "loading";
+        case GameState::NoCharacter: return "no_character";
+        case GameState::InGame: return "in_game";
+    }
+    return "unknown";
+}
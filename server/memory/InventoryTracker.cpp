@@ -0,0 +1,121 @@
+#include "InventoryTracker.h"
+#include "BlockDiff.h"
+#include "DS3Fields.h"
+#include "MemoryReader.h"
+#include "ReadMetrics.h"
+#include "SnapshotMemorySource.h"
+
+#include <cstring>
+
+namespace {
+    constexpr size_t INVENTORY_SIZE = DS3Fields::INVENTORY_SLOT_COUNT * sizeof(InventorySlot);
+
+    // A changed span then always covers whole slots.
+    static_assert(sizeof(InventorySlot) == 16 && BlockDiff::SPAN_SIZE % sizeof(InventorySlot) == 0);
+
+    bool IsEmpty(const InventorySlot& slot) {
+        return slot.itemId == DS3Fields::EMPTY_ITEM_ID;
+    }
+
+    void DiffSlot(const InventorySlot& before, const InventorySlot& after, int32_t slot, std::vector<InventoryChange>& changes) {
+        if (!IsEmpty(before) && before.itemId == after.itemId) {
+            int64_t delta = static_cast<int64_t>(after.quantity) - before.quantity;
+            if (delta != 0) {
+                changes.push_back({InventoryChangeKind::Item, after.itemId, slot, delta, after.quantity});
+            }
+            return;
+        }
+
+        if (!IsEmpty(before)) {
+            changes.push_back({InventoryChangeKind::Item, before.itemId, slot, -static_cast<int64_t>(before.quantity), 0});
+        }
+        if (!IsEmpty(after)) {
+            changes.push_back({InventoryChangeKind::Item, after.itemId, slot, after.quantity, after.quantity});
+        }
+    }
+}
+
+InventoryTracker::InventoryTracker()
+    : previous(INVENTORY_SIZE), current(INVENTORY_SIZE), readMetric(GetReadMetrics().Register("inventory")) {}
+
+template<MemorySource Source>
+bool InventoryTracker::PollItems(Source& source, uintptr_t region, std::vector<InventoryChange>& changes) {
+    ScopedReadTimer timer(readMetric);
+
+    const MemoryRead read[] = {{region, current.data(), current.size()}};
+    if (region == 0 || !source.ReadBatch(read)) {
+        timer.SetSucceeded(false);
+        return false;
+    }
+
+    if (!hasItems) {
+        for (size_t at = 0; at < INVENTORY_SIZE; at += sizeof(InventorySlot)) {
+            InventorySlot slot;
+            std::memcpy(&slot, current.data() + at, sizeof(slot));
+            if (!IsEmpty(slot)) {
+                changes.push_back({InventoryChangeKind::Item, slot.itemId, static_cast<int32_t>(at / sizeof(InventorySlot)),
+                    slot.quantity, slot.quantity, true});
+            }
+        }
+    } else {
+        changedSpans.clear();
+        BlockDiff::ChangedSpans(previous, current, changedSpans);
+
+        for (uint32_t offset : changedSpans) {
+            for (size_t at = offset; at < offset + BlockDiff::SPAN_SIZE && at < INVENTORY_SIZE; at += sizeof(InventorySlot)) {
+                InventorySlot before;
+                InventorySlot after;
+                std::memcpy(&before, previous.data() + at, sizeof(before));
+                std::memcpy(&after, current.data() + at, sizeof(after));
+                DiffSlot(before, after, static_cast<int32_t>(at / sizeof(InventorySlot)), changes);
+            }
+        }
+    }
+
+    previous.swap(current);
+    hasItems = true;
+    return true;
+}
+
+void InventoryTracker::UpdateSouls(uint32_t value, std::vector<InventoryChange>& changes) {
+    // Written even at zero, so every baseline has a souls row.
+    if (!hasSouls) {
+        changes.push_back({InventoryChangeKind::Souls, 0, -1, value, value, true});
+    } else if (value != souls) {
+        changes.push_back({InventoryChangeKind::Souls, 0, -1, static_cast<int64_t>(value) - souls, value});
+    }
+    souls = value;
+    hasSouls = true;
+}
+
+void InventoryTracker::UpdateEquipment(std::span<const uint32_t> items, std::vector<InventoryChange>& changes) {
+    if (equipped.empty()) {
+        for (size_t slot = 0; slot < items.size(); ++slot) {
+            if (items[slot] != DS3Fields::EMPTY_ITEM_ID) {
+                changes.push_back({InventoryChangeKind::Equip, items[slot], static_cast<int32_t>(slot), 1, 1, true});
+            }
+        }
+    } else if (equipped.size() == items.size()) {
+        for (size_t slot = 0; slot < items.size(); ++slot) {
+            if (equipped[slot] == items[slot]) {
+                continue;
+            }
+            if (equipped[slot] != DS3Fields::EMPTY_ITEM_ID) {
+                changes.push_back({InventoryChangeKind::Equip, equipped[slot], static_cast<int32_t>(slot), -1, 0});
+            }
+            if (items[slot] != DS3Fields::EMPTY_ITEM_ID) {
+                changes.push_back({InventoryChangeKind::Equip, items[slot], static_cast<int32_t>(slot), 1, 1});
+            }
+        }
+    }
+    equipped.assign(items.begin(), items.end());
+}
+
+void InventoryTracker::Reset() {
+    hasItems = false;
+    hasSouls = false;
+    equipped.clear();
+}
+
+template bool InventoryTracker::PollItems<MemoryReader>(MemoryReader&, uintptr_t, std::vector<InventoryChange>&);
+template bool InventoryTracker::PollItems<SnapshotMemorySource>(SnapshotMemorySource&, uintptr_t, std::vector<InventoryChange>&);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MemorySource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// One normal item slot of the inventory, as the game lays it out.
+struct InventorySlot {
+    uint32_t handle;
+    uint32_t itemId;
+    uint32_t quantity;
+    uint32_t reserved;
+};
+
+enum class InventoryChangeKind : uint8_t {
+    Item,       // quantity of an item in an inventory slot; estus charges are the flask's quantity
+    Souls,
+    Equip       // an item put into (+1) or taken out of (-1) an equip slot
+};
+
+struct InventoryChange {
+    InventoryChangeKind kind;
+    uint32_t itemId;        // 0 for souls
+    int32_t slot;           // inventory or equip slot, -1 for souls
+    int64_t delta;
+    int64_t quantity;       // after the change; 1 or 0 for equip slots
+    bool isBaseline = false;    // part of a baseline: delta equals quantity
+};
+
+// Follows souls, the item slots and the equip slots, and reports what changed since the
+// previous poll. The item slots are read as one block and only the spans BlockDiff reports
+// as changed are decoded, so apart from that compare the work done is per change, not per
+// slot. An item moved to another slot shows up as removed from one and added to the other.
+// The first poll of each part after construction or Reset reports a baseline instead: souls,
+// every occupied slot and every equipped item, as changes from nothing. Holdings are then the
+// latest baseline of each kind plus the changes after it.
+class InventoryTracker {
+private:
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> current;
+    std::vector<uint32_t> changedSpans;
+    bool hasItems = false;
+
+    uint32_t souls = 0;
+    bool hasSouls = false;
+
+    std::vector<uint32_t> equipped;
+
+    size_t readMetric = 0;
+
+public:
+    InventoryTracker();
+
+    template<MemorySource Source>
+    bool PollItems(Source& source, uintptr_t region, std::vector<InventoryChange>& changes);
+
+    void UpdateSouls(uint32_t value, std::vector<InventoryChange>& changes);
+    void UpdateEquipment(std::span<const uint32_t> items, std::vector<InventoryChange>& changes);
+
+    void Reset();
+};
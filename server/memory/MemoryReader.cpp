@@ -1,8 +1,10 @@
+#ifdef _WIN32
+
 #include "MemoryReader.h"
 
 #include <tlhelp32.h>
 
-MemoryReader::MemoryReader() : processHandle(nullptr), processId(0), moduleBase(0) {}
+MemoryReader::MemoryReader() : processHandle(nullptr), processId(0), moduleBase(0), moduleSize(0) {}
 
 MemoryReader::~MemoryReader() {
     if (processHandle) {
@@ -10,9 +12,11 @@ MemoryReader::~MemoryReader() {
     }
 }
 
-bool MemoryReader::FindProcess(const std::wstring& processName) {
+std::vector<MemoryReader::ProcessId> MemoryReader::FindProcesses(const std::wstring& processName) {
+    std::vector<ProcessId> processIds;
+
     HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) return false;
+    if (snapshot == INVALID_HANDLE_VALUE) return processIds;
 
     PROCESSENTRY32 processEntry = {};
     processEntry.dwSize = sizeof(PROCESSENTRY32);
@@ -20,17 +24,33 @@ bool MemoryReader::FindProcess(const std::wstring& processName) {
     if (Process32First(snapshot, &processEntry)) {
         do {
             if (wcscmp(processName.c_str(), processEntry.szExeFile) == 0) {
-                processId = processEntry.th32ProcessID;
-                CloseHandle(snapshot);
-                return true;
+                processIds.push_back(processEntry.th32ProcessID);
             }
         } while (Process32Next(snapshot, &processEntry));
     }
 
     CloseHandle(snapshot);
+    return processIds;
+}
+
+bool MemoryReader::FindProcess(const std::wstring& processName) {
+    for (ProcessId candidate : FindProcesses(processName)) {
+        if (targetProcessId == 0 || candidate == targetProcessId) {
+            processId = candidate;
+            return true;
+        }
+    }
     return false;
 }
 
+void MemoryReader::SetTargetProcess(ProcessId processId) {
+    targetProcessId = processId;
+}
+
+MemoryReader::ProcessId MemoryReader::GetProcessId() const {
+    return processId;
+}
+
 bool MemoryReader::FindModuleBase(const std::wstring& moduleName) {
     HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, processId);
     if (snapshot == INVALID_HANDLE_VALUE) return false;
@@ -42,6 +62,7 @@ bool MemoryReader::FindModuleBase(const std::wstring& moduleName) {
         do {
             if (wcscmp(moduleName.c_str(), moduleEntry.szModule) == 0) {
                 moduleBase = reinterpret_cast<uintptr_t>(moduleEntry.modBaseAddr);
+                moduleSize = moduleEntry.modBaseSize;
                 CloseHandle(snapshot);
                 return true;
             }
@@ -74,10 +95,30 @@ std::expected<void, MemoryReaderError> MemoryReader::Initialize(const std::wstri
     return {};
 }
 
+bool MemoryReader::ReadBatch(std::span<const MemoryRead> reads) {
+    if (!processHandle) {
+        return false;
+    }
+
+    for (const auto& read : reads) {
+        SIZE_T bytesRead = 0;
+        if (!ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(read.address), read.buffer, read.size, &bytesRead) ||
+            bytesRead != read.size) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 uintptr_t MemoryReader::GetModuleBase() const {
     return moduleBase;
 }
 
+size_t MemoryReader::GetModuleSize() const {
+    return moduleSize;
+}
+
 bool MemoryReader::IsInitialized() const {
     return processHandle != nullptr;
 }
@@ -102,4 +143,7 @@ void MemoryReader::Reset() {
     }
     processId = 0;
     moduleBase = 0;
+    moduleSize = 0;
 }
+
+#endif
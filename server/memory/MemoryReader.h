@@ -1,22 +1,38 @@
 #pragma once
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+
+#include "MemorySource.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <span>
 #include <string>
-
-enum class MemoryReaderError {
-    ProcessNotFound,
-    AccessDenied,
-    ModuleNotFound,
-    ReadFailed
-};
+#include <vector>
 
 class MemoryReader {
+public:
+#ifdef _WIN32
+    using ProcessId = DWORD;
+#else
+    using ProcessId = pid_t;
+#endif
+
 private:
+#ifdef _WIN32
     HANDLE processHandle;
-    DWORD processId;
+#endif
+    ProcessId processId;
+    ProcessId targetProcessId = 0;
     uintptr_t moduleBase;
+    size_t moduleSize;
 
     bool FindProcess(const std::wstring& processName);
     bool FindModuleBase(const std::wstring& moduleName);
@@ -29,8 +45,16 @@ public:
 
     ~MemoryReader();
 
+    // Every running process with this executable name, e.g. several Proton prefixes on one box.
+    static std::vector<ProcessId> FindProcesses(const std::wstring& processName);
+
+    // Restricts Initialize to one process; 0 attaches to the first match.
+    void SetTargetProcess(ProcessId processId);
+    ProcessId GetProcessId() const;
+
     template<typename T>
     bool ReadMemory(uintptr_t address, T& value) {
+#ifdef _WIN32
         if (!processHandle) {
             return false;
         }
@@ -38,10 +62,24 @@ public:
         SIZE_T bytesRead = 0;
         return ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address),
             &value, sizeof(T), &bytesRead) && bytesRead == sizeof(T);
+#else
+        if (processId <= 0) {
+            return false;
+        }
+
+        iovec local{&value, sizeof(T)};
+        iovec remote{reinterpret_cast<void*>(address), sizeof(T)};
+        return process_vm_readv(processId, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(sizeof(T));
+#endif
     }
 
+    // Reads every entry in one pass: a single process_vm_readv per IOV_MAX entries on Linux,
+    // one ReadProcessMemory per entry on Windows. Fails if any entry is not read in full.
+    bool ReadBatch(std::span<const MemoryRead> reads);
+
     std::expected<void, MemoryReaderError> Initialize(const std::wstring& processName);
     uintptr_t GetModuleBase() const;
+    size_t GetModuleSize() const;
     bool IsInitialized() const;
     bool IsProcessRunning() const;
     void Reset();
@@ -0,0 +1,196 @@
+#ifndef _WIN32
+
+#include "MemoryReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <signal.h>
+#include <sstream>
+#include <vector>
+
+static std::string ToNarrow(const std::wstring& wstr) {
+    std::string result;
+    result.reserve(wstr.size());
+    for (wchar_t c : wstr) {
+        result.push_back(static_cast<char>(c));
+    }
+    return result;
+}
+
+// Wine and Proton launch the game as "Z:\...\DarkSoulsIII.exe" or "/.../DarkSoulsIII.exe",
+// so both separators are stripped before comparing.
+static std::string BaseName(const std::string& path) {
+    size_t separator = path.find_last_of("/\\");
+    return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+
+MemoryReader::MemoryReader() : processId(0), moduleBase(0), moduleSize(0) {}
+
+MemoryReader::~MemoryReader() = default;
+
+std::vector<MemoryReader::ProcessId> MemoryReader::FindProcesses(const std::wstring& processName) {
+    std::string target = ToNarrow(processName);
+    std::vector<ProcessId> processIds;
+
+    DIR* procDir = opendir("/proc");
+    if (!procDir) return processIds;
+
+    while (dirent* entry = readdir(procDir)) {
+        char* end = nullptr;
+        long pid = std::strtol(entry->d_name, &end, 10);
+        if (*end != '\0' || pid <= 0) {
+            continue;
+        }
+
+        std::ifstream cmdlineFile("/proc/" + std::string(entry->d_name) + "/cmdline");
+        std::string executable;
+        if (!std::getline(cmdlineFile, executable, '\0')) {
+            continue;
+        }
+
+        if (BaseName(executable) == target) {
+            processIds.push_back(static_cast<pid_t>(pid));
+        }
+    }
+
+    closedir(procDir);
+    std::sort(processIds.begin(), processIds.end());
+    return processIds;
+}
+
+bool MemoryReader::FindProcess(const std::wstring& processName) {
+    for (ProcessId candidate : FindProcesses(processName)) {
+        if (targetProcessId == 0 || candidate == targetProcessId) {
+            processId = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MemoryReader::SetTargetProcess(ProcessId processId) {
+    targetProcessId = processId;
+}
+
+MemoryReader::ProcessId MemoryReader::GetProcessId() const {
+    return processId;
+}
+
+bool MemoryReader::FindModuleBase(const std::wstring& moduleName) {
+    std::string target = ToNarrow(moduleName);
+
+    std::ifstream mapsFile("/proc/" + std::to_string(processId) + "/maps");
+    if (!mapsFile) return false;
+
+    uintptr_t lowest = UINTPTR_MAX;
+    uintptr_t highest = 0;
+    std::string line;
+    while (std::getline(mapsFile, line)) {
+        std::istringstream fields(line);
+        std::string range, perms, offset, device, inode, path;
+        fields >> range >> perms >> offset >> device >> inode;
+        std::getline(fields >> std::ws, path);
+
+        if (path.empty() || BaseName(path) != target) {
+            continue;
+        }
+
+        size_t separator = range.find('-');
+        uintptr_t start = std::strtoull(range.c_str(), nullptr, 16);
+        uintptr_t end = std::strtoull(range.c_str() + separator + 1, nullptr, 16);
+        lowest = std::min(lowest, start);
+        highest = std::max(highest, end);
+    }
+
+    if (lowest == UINTPTR_MAX) {
+        return false;
+    }
+
+    moduleBase = lowest;
+    moduleSize = highest - lowest;
+    return true;
+}
+
+std::expected<void, MemoryReaderError> MemoryReader::Initialize(const std::wstring& processName) {
+    Reset();
+
+    if (!FindProcess(processName)) {
+        return std::unexpected(MemoryReaderError::ProcessNotFound);
+    }
+
+    if (!FindModuleBase(processName)) {
+        processId = 0;
+        return std::unexpected(MemoryReaderError::ModuleNotFound);
+    }
+
+    uint16_t dosMagic = 0;
+    if (!ReadMemory(moduleBase, dosMagic)) {
+        bool denied = errno == EPERM;
+        Reset();
+        return std::unexpected(denied ? MemoryReaderError::AccessDenied : MemoryReaderError::ReadFailed);
+    }
+
+    return {};
+}
+
+bool MemoryReader::ReadBatch(std::span<const MemoryRead> reads) {
+    if (processId <= 0) {
+        return false;
+    }
+
+    std::vector<iovec> local;
+    std::vector<iovec> remote;
+    local.reserve(std::min<size_t>(reads.size(), IOV_MAX));
+    remote.reserve(std::min<size_t>(reads.size(), IOV_MAX));
+
+    for (size_t start = 0; start < reads.size(); start += IOV_MAX) {
+        size_t count = std::min<size_t>(reads.size() - start, IOV_MAX);
+        ssize_t expected = 0;
+
+        local.clear();
+        remote.clear();
+        for (const auto& read : reads.subspan(start, count)) {
+            local.push_back({read.buffer, read.size});
+            remote.push_back({reinterpret_cast<void*>(read.address), read.size});
+            expected += static_cast<ssize_t>(read.size);
+        }
+
+        if (process_vm_readv(processId, local.data(), count, remote.data(), count, 0) != expected) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uintptr_t MemoryReader::GetModuleBase() const {
+    return moduleBase;
+}
+
+size_t MemoryReader::GetModuleSize() const {
+    return moduleSize;
+}
+
+bool MemoryReader::IsInitialized() const {
+    return processId > 0;
+}
+
+bool MemoryReader::IsProcessRunning() const {
+    if (processId <= 0) {
+        return false;
+    }
+
+    return kill(processId, 0) == 0 || errno == EPERM;
+}
+
+void MemoryReader::Reset() {
+    processId = 0;
+    moduleBase = 0;
+    moduleSize = 0;
+}
+
+#endif
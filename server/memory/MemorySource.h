@@ -0,0 +1,37 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+
+enum class MemoryReaderError {
+    ProcessNotFound,
+    AccessDenied,
+    ModuleNotFound,
+    ReadFailed,
+    NotLoaded       // the chain is behind a pointer that is null on load screens or without a character
+};
+
+struct MemoryRead {
+    uintptr_t address;
+    void* buffer;
+    size_t size;
+};
+
+// Anything DS3StatsReader can read the game from. Readers take the source as a template
+// parameter, so dispatch is static and there is no virtual call per read.
+template<typename T>
+concept MemorySource = requires(T source, const T& constSource, uintptr_t address, uint32_t& value,
+    std::span<const MemoryRead> reads, const std::wstring& processName) {
+    { source.ReadMemory(address, value) } -> std::same_as<bool>;
+    { source.ReadBatch(reads) } -> std::same_as<bool>;
+    { source.Initialize(processName) } -> std::same_as<std::expected<void, MemoryReaderError>>;
+    { constSource.GetModuleBase() } -> std::same_as<uintptr_t>;
+    { constSource.GetModuleSize() } -> std::same_as<size_t>;
+    { constSource.IsInitialized() } -> std::same_as<bool>;
+    { constSource.IsProcessRunning() } -> std::same_as<bool>;
+    { source.Reset() };
+};
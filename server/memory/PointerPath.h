@@ -0,0 +1,173 @@
+#pragma once
+
+#include "MemorySource.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+enum class PathRoot : size_t {
+    GameDataMan,
+    WorldChrMan,
+    EventFlagMan
+};
+
+inline constexpr size_t PATH_ROOT_COUNT = 3;
+
+inline const char* pathRootToString(PathRoot root) {
+    switch (root) {
+        case PathRoot::GameDataMan: return "GameDataMan";
+        case PathRoot::WorldChrMan: return "WorldChrMan";
+        case PathRoot::EventFlagMan: return "EventFlagMan";
+    }
+    return "Unknown";
+}
+
+// A pointer chain described in the type: the root pointer, then each offset is added and
+// dereferenced in turn. Following a path is a fold over the offsets, so the read code is
+// fully unrolled at compile time.
+template<PathRoot Root, uintptr_t... Offsets>
+struct PointerPath {
+    static constexpr PathRoot root = Root;
+    static constexpr size_t depth = sizeof...(Offsets);
+    static constexpr std::array<uintptr_t, sizeof...(Offsets)> offsets = {Offsets...};
+
+    // e.g. "WorldChrMan+0x80+0x1F90", for logs and metrics.
+    static std::string Describe() {
+        std::string description = pathRootToString(Root);
+        for (uintptr_t offset : offsets) {
+            char part[24];
+            std::snprintf(part, sizeof(part), "+0x%llX", static_cast<unsigned long long>(offset));
+            description += part;
+        }
+        return description;
+    }
+
+    // Dereferences offsets [From, depth) starting from an already resolved address.
+    template<size_t From, MemorySource Source>
+    static bool Follow(Source& source, uintptr_t& address) {
+        return FollowOffsets<From>(source, address, std::make_index_sequence<depth - From>{});
+    }
+
+private:
+    template<size_t From, MemorySource Source, size_t... I>
+    static bool FollowOffsets(Source& source, uintptr_t& address, std::index_sequence<I...>) {
+        return ((address != 0 && source.ReadMemory(address + offsets[From + I], address)) && ...) && address != 0;
+    }
+};
+
+// A value of type T at Offset inside the block a path resolves to.
+template<typename Path, uintptr_t Offset, typename T>
+struct PathField {
+    using Chain = Path;
+    using Value = T;
+    static constexpr uintptr_t offset = Offset;
+};
+
+template<typename... Ts>
+struct TypeList {
+    static constexpr size_t size = sizeof...(Ts);
+};
+
+namespace PathDetail {
+    template<typename T, typename List>
+    struct IndexOf;
+
+    template<typename T, typename... Ts>
+    struct IndexOf<T, TypeList<Ts...>> {
+        static constexpr size_t value = [] {
+            constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+            for (size_t i = 0; i < sizeof...(Ts); ++i) {
+                if (matches[i]) {
+                    return i;
+                }
+            }
+            return sizeof...(Ts);
+        }();
+    };
+
+    template<typename List, typename... Ts>
+    struct Unique {
+        using type = List;
+    };
+
+    template<typename... Us, typename T, typename... Ts>
+    struct Unique<TypeList<Us...>, T, Ts...> {
+        using type = typename Unique<
+            std::conditional_t<(std::is_same_v<T, Us> || ...), TypeList<Us...>, TypeList<Us..., T>>, Ts...>::type;
+    };
+
+    template<size_t I, typename List>
+    struct At;
+
+    template<size_t I, typename... Ts>
+    struct At<I, TypeList<Ts...>> {
+        using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+    };
+
+    template<typename Prefix, typename Path>
+    constexpr bool IsProperPrefix() {
+        if (Prefix::root != Path::root || Prefix::depth >= Path::depth) {
+            return false;
+        }
+        for (size_t i = 0; i < Prefix::depth; ++i) {
+            if (Prefix::offsets[i] != Path::offsets[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Path, typename... Chains>
+    constexpr size_t LongestPrefix(TypeList<Chains...>) {
+        constexpr bool isPrefix[] = {IsProperPrefix<Chains, Path>()...};
+        constexpr size_t depths[] = {Chains::depth...};
+
+        size_t best = sizeof...(Chains);
+        for (size_t i = 0; i < sizeof...(Chains); ++i) {
+            if (isPrefix[i] && (best == sizeof...(Chains) || depths[i] > depths[best])) {
+                best = i;
+            }
+        }
+        return best;
+    }
+}
+
+struct FieldSpec {
+    size_t chain;
+    uintptr_t offset;
+    size_t size;
+};
+
+// The full set of fields a reader samples. Distinct chains are collected statically, each
+// root path is added, and every chain records the longest other chain that prefixes it, so
+// a shared prefix is dereferenced once and reused by everything below it.
+template<typename... Fields>
+struct FieldSet {
+    using Chains = typename PathDetail::Unique<TypeList<>,
+        PointerPath<Fields::Chain::root>..., typename Fields::Chain...>::type;
+
+    static constexpr size_t count = sizeof...(Fields);
+
+    template<typename Field>
+    static constexpr size_t indexOf = PathDetail::IndexOf<Field, TypeList<Fields...>>::value;
+
+    template<typename Chain>
+    static constexpr size_t chainIndexOf = PathDetail::IndexOf<Chain, Chains>::value;
+
+    template<size_t I>
+    using ChainAt = typename PathDetail::At<I, Chains>::type;
+
+    // Index of the chain a chain is resolved from, or Chains::size for roots.
+    template<size_t I>
+    static constexpr size_t parentOf = PathDetail::LongestPrefix<ChainAt<I>>(Chains{});
+
+    static constexpr std::array<FieldSpec, sizeof...(Fields)> specs = {
+        FieldSpec{chainIndexOf<typename Fields::Chain>, Fields::offset, sizeof(typename Fields::Value)}...
+    };
+};
@@ -0,0 +1,132 @@
+#include "ProcessWatcher.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+ProcessWatcher::~ProcessWatcher() {
+    for (Watched& entry : watched) {
+        Close(entry);
+    }
+}
+
+void ProcessWatcher::Close(Watched& entry) {
+#ifdef _WIN32
+    CloseHandle(entry.handle);
+#else
+    if (entry.fd >= 0) {
+        close(entry.fd);
+    }
+#endif
+}
+
+bool ProcessWatcher::Add(MemoryReader::ProcessId processId) {
+    auto existing = std::find_if(watched.begin(), watched.end(),
+        [&](const Watched& entry) { return entry.processId == processId; });
+    if (existing != watched.end()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    // WaitForMultipleObjects takes at most MAXIMUM_WAIT_OBJECTS handles.
+    if (watched.size() == MAXIMUM_WAIT_OBJECTS) {
+        return false;
+    }
+
+    HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, processId);
+    if (!handle) {
+        return false;
+    }
+    watched.push_back({processId, handle});
+#else
+#ifdef SYS_pidfd_open
+    int fd = static_cast<int>(syscall(SYS_pidfd_open, processId, 0));
+#else
+    int fd = -1;
+#endif
+    // Without pidfd support the process is probed with kill(0) on every wait instead.
+    if (fd < 0 && kill(processId, 0) != 0) {
+        return false;
+    }
+    watched.push_back({processId, fd});
+#endif
+
+    return true;
+}
+
+void ProcessWatcher::Remove(MemoryReader::ProcessId processId) {
+    auto entry = std::find_if(watched.begin(), watched.end(),
+        [&](const Watched& candidate) { return candidate.processId == processId; });
+    if (entry == watched.end()) {
+        return;
+    }
+
+    Close(*entry);
+    watched.erase(entry);
+}
+
+std::vector<MemoryReader::ProcessId> ProcessWatcher::WaitForExits(std::chrono::milliseconds timeout) {
+    std::vector<MemoryReader::ProcessId> exited;
+
+    if (watched.empty()) {
+        std::this_thread::sleep_for(timeout);
+        return exited;
+    }
+
+#ifdef _WIN32
+    std::vector<HANDLE> handles;
+    handles.reserve(watched.size());
+    for (const Watched& entry : watched) {
+        handles.push_back(entry.handle);
+    }
+
+    DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE,
+        static_cast<DWORD>(timeout.count()));
+    if (result == WAIT_TIMEOUT) {
+        return exited;
+    }
+    if (result == WAIT_FAILED) {
+        Sleep(static_cast<DWORD>(timeout.count()));
+    }
+
+    // Several processes may have exited together, so every handle is checked, not just the one reported.
+    for (const Watched& entry : watched) {
+        if (WaitForSingleObject(entry.handle, 0) == WAIT_OBJECT_0) {
+            exited.push_back(entry.processId);
+        }
+    }
+#else
+    std::vector<pollfd> descriptors;
+    descriptors.reserve(watched.size());
+    bool anyPolled = false;
+    for (const Watched& entry : watched) {
+        descriptors.push_back({entry.fd, POLLIN, 0});
+        anyPolled = anyPolled || entry.fd >= 0;
+    }
+
+    if (anyPolled) {
+        poll(descriptors.data(), descriptors.size(), static_cast<int>(timeout.count()));
+    } else {
+        std::this_thread::sleep_for(timeout);
+    }
+
+    for (size_t i = 0; i < watched.size(); ++i) {
+        bool gone = watched[i].fd >= 0 ? (descriptors[i].revents & POLLIN) != 0 : kill(watched[i].processId, 0) != 0;
+        if (gone) {
+            exited.push_back(watched[i].processId);
+        }
+    }
+#endif
+
+    for (MemoryReader::ProcessId processId : exited) {
+        Remove(processId);
+    }
+
+    return exited;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "MemoryReader.h"
+
+#include <chrono>
+#include <vector>
+
+// Waits on the exit of several processes at once, so one thread can notice any tracked
+// game closing without polling each of them.
+class ProcessWatcher {
+private:
+    struct Watched {
+        MemoryReader::ProcessId processId;
+#ifdef _WIN32
+        HANDLE handle;
+#else
+        int fd;
+#endif
+    };
+
+    std::vector<Watched> watched;
+
+    static void Close(Watched& entry);
+
+public:
+    ProcessWatcher() = default;
+    ~ProcessWatcher();
+
+    ProcessWatcher(const ProcessWatcher&) = delete;
+    ProcessWatcher& operator=(const ProcessWatcher&) = delete;
+
+    // False if the process is already gone or cannot be opened for waiting.
+    bool Add(MemoryReader::ProcessId processId);
+    void Remove(MemoryReader::ProcessId processId);
+
+    // Blocks until at least one watched process exits or the timeout passes, then returns
+    // and stops watching every process that exited.
+    std::vector<MemoryReader::ProcessId> WaitForExits(std::chrono::milliseconds timeout);
+};
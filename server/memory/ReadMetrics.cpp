@@ -0,0 +1,103 @@
+#include "ReadMetrics.h"
+
+#include <algorithm>
+#include <bit>
+
+ReadMetrics& GetReadMetrics() {
+    static ReadMetrics readMetrics;
+    return readMetrics;
+}
+
+uint64_t ReadMetricSummary::PercentileNs(double percentile) const {
+    if (calls == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(static_cast<double>(calls) * percentile / 100.0);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += histogram[bucket];
+        if (seen > target) {
+            return uint64_t{1} << bucket;
+        }
+    }
+
+    return uint64_t{1} << (BUCKETS - 1);
+}
+
+ReadMetrics::Shard& ReadMetrics::LocalShard() {
+    // One registry per process (GetReadMetrics), so a plain thread_local is enough.
+    thread_local Shard* shard = nullptr;
+    if (!shard) {
+        std::lock_guard<std::mutex> lock(mutex);
+        shards.push_back(std::make_unique<Shard>());
+        shard = shards.back().get();
+    }
+    return *shard;
+}
+
+size_t ReadMetrics::Register(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto existing = std::find(names.begin(), names.end(), name);
+    if (existing != names.end()) {
+        return static_cast<size_t>(existing - names.begin());
+    }
+
+    if (names.size() == MAX_KEYS) {
+        return MAX_KEYS - 1;
+    }
+
+    names.push_back(name);
+    return names.size() - 1;
+}
+
+void ReadMetrics::Record(size_t key, std::chrono::nanoseconds elapsed, bool succeeded) {
+    Counter& counter = LocalShard().counters[key];
+    uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+    size_t bucket = std::min<size_t>(std::bit_width(ns), BUCKETS - 1);
+
+    // Only the owning thread writes a shard, so load + store is enough and avoids locked adds.
+    auto bump = [](std::atomic<uint64_t>& value, uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    };
+
+    bump(counter.calls, 1);
+    bump(counter.totalNs, ns);
+    bump(counter.histogram[bucket], 1);
+    if (!succeeded) {
+        bump(counter.failures, 1);
+    }
+}
+
+std::vector<ReadMetricSummary> ReadMetrics::Collect() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<ReadMetricSummary> summaries(names.size());
+    for (size_t key = 0; key < names.size(); ++key) {
+        ReadMetricSummary& summary = summaries[key];
+        summary.name = names[key];
+
+        for (const auto& shard : shards) {
+            const Counter& counter = shard->counters[key];
+            summary.calls += counter.calls.load(std::memory_order_relaxed);
+            summary.failures += counter.failures.load(std::memory_order_relaxed);
+            summary.totalNs += counter.totalNs.load(std::memory_order_relaxed);
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                summary.histogram[bucket] += counter.histogram[bucket].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    return summaries;
+}
+
+ScopedReadTimer::ScopedReadTimer(size_t key) : key(key), start(std::chrono::steady_clock::now()) {}
+
+ScopedReadTimer::~ScopedReadTimer() {
+    GetReadMetrics().Record(key, std::chrono::steady_clock::now() - start, succeeded);
+}
+
+void ScopedReadTimer::SetSucceeded(bool value) {
+    succeeded = value;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ReadMetricSummary {
+    static constexpr size_t BUCKETS = 32;
+
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t failures = 0;
+    uint64_t totalNs = 0;
+
+    // Bucket i counts calls that took [2^(i-1), 2^i) ns; the last bucket is open ended.
+    std::array<uint64_t, BUCKETS> histogram{};
+
+    // Upper bound of the bucket holding the given percentile, in nanoseconds.
+    uint64_t PercentileNs(double percentile) const;
+};
+
+// Read counters and latency histograms keyed by name. Each thread records into its own
+// shard with plain relaxed stores, so recording never contends; Collect merges the shards.
+class ReadMetrics {
+private:
+    static constexpr size_t MAX_KEYS = 256;
+    static constexpr size_t BUCKETS = ReadMetricSummary::BUCKETS;
+
+    struct Counter {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::array<std::atomic<uint64_t>, BUCKETS> histogram{};
+    };
+
+    struct Shard {
+        std::array<Counter, MAX_KEYS> counters;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::string> names;
+
+    // Shards outlive their threads so counts from finished threads are kept.
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& LocalShard();
+
+public:
+    // Returns the key for a name, registering it on first use. Fails over to the last key
+    // once MAX_KEYS names are registered.
+    size_t Register(const std::string& name);
+
+    void Record(size_t key, std::chrono::nanoseconds elapsed, bool succeeded);
+
+    std::vector<ReadMetricSummary> Collect() const;
+};
+
+// Records the time from construction to destruction under one key.
+class ScopedReadTimer {
+private:
+    size_t key;
+    std::chrono::steady_clock::time_point start;
+    bool succeeded = true;
+
+public:
+    explicit ScopedReadTimer(size_t key);
+    ~ScopedReadTimer();
+
+    ScopedReadTimer(const ScopedReadTimer&) = delete;
+    ScopedReadTimer& operator=(const ScopedReadTimer&) = delete;
+
+    void SetSucceeded(bool value);
+};
+
+// The process-wide registry. Created on first use, so readers constructed during static
+// initialization of other translation units (g_gameSamplers) can register keys safely.
+ReadMetrics& GetReadMetrics();
@@ -0,0 +1,69 @@
+#include "ReadPlan.h"
+
+#include <algorithm>
+#include <numeric>
+
+size_t ReadPlan::AddField(size_t chain, uintptr_t offset, size_t size) {
+    fields.push_back({chain, offset, size, 0, 0});
+    return fields.size() - 1;
+}
+
+void ReadPlan::Compile() {
+    blocks.clear();
+
+    std::vector<size_t> order(fields.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        if (fields[a].chain != fields[b].chain) {
+            return fields[a].chain < fields[b].chain;
+        }
+        return fields[a].offset < fields[b].offset;
+    });
+
+    size_t bufferSize = 0;
+    for (size_t index : order) {
+        PlannedField& field = fields[index];
+
+        bool extendsLast = !blocks.empty() &&
+            blocks.back().chain == field.chain &&
+            field.offset <= blocks.back().offset + blocks.back().size + MAX_GAP;
+
+        if (!extendsLast) {
+            blocks.push_back({field.chain, field.offset, 0, 0});
+        }
+
+        PlannedBlock& block = blocks.back();
+        block.size = std::max(block.size, field.offset + field.size - block.offset);
+
+        field.block = blocks.size() - 1;
+        field.blockOffset = field.offset - block.offset;
+    }
+
+    for (auto& block : blocks) {
+        block.bufferOffset = bufferSize;
+        bufferSize += block.size;
+    }
+
+    buffer.assign(bufferSize, 0);
+    blockValid.assign(blocks.size(), false);
+}
+
+std::span<const PlannedBlock> ReadPlan::GetBlocks() const {
+    return blocks;
+}
+
+size_t ReadPlan::GetFieldBlock(size_t field) const {
+    return fields[field].block;
+}
+
+uint8_t* ReadPlan::GetBlockData(size_t block) {
+    return buffer.data() + blocks[block].bufferOffset;
+}
+
+void ReadPlan::SetBlockValid(size_t block, bool valid) {
+    blockValid[block] = valid;
+}
+
+void ReadPlan::InvalidateAll() {
+    std::fill(blockValid.begin(), blockValid.end(), false);
+}
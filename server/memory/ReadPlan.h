@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+struct PlannedField {
+    size_t chain;
+    uintptr_t offset;
+    size_t size;
+    size_t block;
+    size_t blockOffset;
+};
+
+struct PlannedBlock {
+    size_t chain;
+    uintptr_t offset;
+    size_t size;
+    size_t bufferOffset;
+};
+
+// Merges the fields read from each pointer chain into as few contiguous block reads as possible.
+// Fields are decoded from the local buffer once the blocks have been filled.
+class ReadPlan {
+private:
+    std::vector<PlannedField> fields;
+    std::vector<PlannedBlock> blocks;
+    std::vector<uint8_t> buffer;
+    std::vector<bool> blockValid;
+
+public:
+    // Ranges separated by at most this many bytes are read as one block.
+    static constexpr size_t MAX_GAP = 0x80;
+
+    size_t AddField(size_t chain, uintptr_t offset, size_t size);
+    void Compile();
+
+    std::span<const PlannedBlock> GetBlocks() const;
+    size_t GetFieldBlock(size_t field) const;
+    uint8_t* GetBlockData(size_t block);
+
+    void SetBlockValid(size_t block, bool valid);
+    void InvalidateAll();
+
+    template<typename T>
+    bool Decode(size_t field, T& value) const {
+        const PlannedField& planned = fields[field];
+        if (planned.size != sizeof(T) || !blockValid[planned.block]) {
+            return false;
+        }
+
+        std::memcpy(&value, buffer.data() + blocks[planned.block].bufferOffset + planned.blockOffset, sizeof(T));
+        return true;
+    }
+};
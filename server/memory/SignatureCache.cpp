@@ -0,0 +1,83 @@
+#include "SignatureCache.h"
+#include "../core/Log.h"
+
+#include "json.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using json = nlohmann::json;
+
+SignatureCache g_signatureCache;
+
+void SignatureCache::Load() {
+    loaded = true;
+
+    std::ifstream cacheFile(FILENAME);
+    if (!cacheFile) {
+        return;
+    }
+
+    try {
+        json cacheData;
+        cacheFile >> cacheData;
+
+        for (const auto& [key, value] : cacheData.items()) {
+            uint64_t moduleHash = std::stoull(key, nullptr, 16);
+            entries[moduleHash] = {
+                value.at("gameDataMan").get<uintptr_t>(),
+                value.at("worldChrMan").get<uintptr_t>(),
+                value.value("eventFlagMan", uintptr_t{0})
+            };
+        }
+    }
+    catch (...) {
+        log(LogLevel::WARN, "Invalid signatures.json, ignoring cached offsets");
+        entries.clear();
+    }
+}
+
+void SignatureCache::Save() {
+    json cacheData = json::object();
+    for (const auto& [moduleHash, roots] : entries) {
+        char key[17];
+        std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(moduleHash));
+        cacheData[key] = {
+            {"gameDataMan", roots.gameDataMan},
+            {"worldChrMan", roots.worldChrMan},
+            {"eventFlagMan", roots.eventFlagMan}
+        };
+    }
+
+    std::ofstream cacheFile(FILENAME);
+    if (!cacheFile) {
+        log(LogLevel::ERR, "Failed to save signature cache");
+        return;
+    }
+
+    cacheFile << cacheData.dump(4);
+}
+
+std::optional<ResolvedRoots> SignatureCache::Find(uint64_t moduleHash) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded) {
+        Load();
+    }
+
+    auto it = entries.find(moduleHash);
+    if (it == entries.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void SignatureCache::Store(uint64_t moduleHash, const ResolvedRoots& roots) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded) {
+        Load();
+    }
+
+    entries[moduleHash] = roots;
+    Save();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+
+struct ResolvedRoots {
+    uintptr_t gameDataMan;
+    uintptr_t worldChrMan;
+    uintptr_t eventFlagMan;     // 0 when the scan did not find it
+};
+
+// Persists signature-scan results per game build, keyed by a hash of the module header,
+// so only the first start on a new executable pays for a scan.
+class SignatureCache {
+private:
+    static constexpr const char* FILENAME = "signatures.json";
+
+    std::mutex mutex;
+    std::map<uint64_t, ResolvedRoots> entries;
+    bool loaded = false;
+
+    void Load();
+    void Save();
+
+public:
+    std::optional<ResolvedRoots> Find(uint64_t moduleHash);
+    void Store(uint64_t moduleHash, const ResolvedRoots& roots);
+};
+
+extern SignatureCache g_signatureCache;
@@ -0,0 +1,232 @@
+#include "SignatureScanner.h"
+#include "../core/CpuFeatures.h"
+
+#include <bit>
+#include <cstring>
+
+namespace {
+    struct Anchors {
+        size_t first;
+        size_t second;
+    };
+
+    // Bytes that open or fill most x64 instructions make poor filters.
+    bool IsCommonByte(uint8_t value) {
+        return value == 0x00 || value == 0xFF || value == 0x48 || value == 0x8B ||
+            value == 0x89 || value == 0x0F || value == 0xCC;
+    }
+
+    Anchors PickAnchors(const Signature& signature) {
+        std::optional<size_t> first;
+        std::optional<size_t> fallback;
+        size_t last = 0;
+
+        for (size_t i = 0; i < signature.bytes.size(); ++i) {
+            if (signature.wildcard[i]) {
+                continue;
+            }
+
+            if (!fallback) {
+                fallback = i;
+            }
+            if (!first && !IsCommonByte(signature.bytes[i])) {
+                first = i;
+            }
+            last = i;
+        }
+
+        size_t firstAnchor = first.value_or(*fallback);
+        size_t secondAnchor = last != firstAnchor ? last : *fallback;
+        return {firstAnchor, secondAnchor};
+    }
+
+    int HexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    bool MatchesAt(const uint8_t* data, const Signature& signature) {
+        for (size_t i = 0; i < signature.bytes.size(); ++i) {
+            if (!signature.wildcard[i] && data[i] != signature.bytes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::optional<size_t> FindScalar(std::span<const uint8_t> image, const Signature& signature, const Anchors& anchors, size_t start) {
+        size_t lastStart = image.size() - signature.bytes.size();
+        uint8_t firstByte = signature.bytes[anchors.first];
+        uint8_t secondByte = signature.bytes[anchors.second];
+
+        for (size_t i = start; i <= lastStart; ++i) {
+            if (image[i + anchors.first] == firstByte && image[i + anchors.second] == secondByte &&
+                MatchesAt(image.data() + i, signature)) {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+#ifdef EMBER_SIMD_X64
+    EMBER_TARGET_AVX2 std::optional<size_t> FindAvx2(std::span<const uint8_t> image, const Signature& signature, const Anchors& anchors) {
+        const uint8_t* data = image.data();
+        size_t candidates = image.size() - signature.bytes.size() + 1;
+        const __m256i firstByte = _mm256_set1_epi8(static_cast<char>(signature.bytes[anchors.first]));
+        const __m256i secondByte = _mm256_set1_epi8(static_cast<char>(signature.bytes[anchors.second]));
+
+        size_t i = 0;
+        for (; i + 32 <= candidates; i += 32) {
+            __m256i firstBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + anchors.first));
+            __m256i secondBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + anchors.second));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+                _mm256_cmpeq_epi8(firstBlock, firstByte), _mm256_cmpeq_epi8(secondBlock, secondByte))));
+
+            while (mask) {
+                size_t candidate = i + static_cast<size_t>(std::countr_zero(mask));
+                if (MatchesAt(data + candidate, signature)) {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        return FindScalar(image, signature, anchors, i);
+    }
+
+    std::optional<size_t> FindSse2(std::span<const uint8_t> image, const Signature& signature, const Anchors& anchors) {
+        const uint8_t* data = image.data();
+        size_t candidates = image.size() - signature.bytes.size() + 1;
+        const __m128i firstByte = _mm_set1_epi8(static_cast<char>(signature.bytes[anchors.first]));
+        const __m128i secondByte = _mm_set1_epi8(static_cast<char>(signature.bytes[anchors.second]));
+
+        size_t i = 0;
+        for (; i + 16 <= candidates; i += 16) {
+            __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + anchors.first));
+            __m128i secondBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + anchors.second));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+                _mm_cmpeq_epi8(firstBlock, firstByte), _mm_cmpeq_epi8(secondBlock, secondByte))));
+
+            while (mask) {
+                size_t candidate = i + static_cast<size_t>(std::countr_zero(mask));
+                if (MatchesAt(data + candidate, signature)) {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        return FindScalar(image, signature, anchors, i);
+    }
+#endif
+}
+
+std::optional<Signature> Signature::Parse(std::string_view pattern) {
+    Signature signature;
+    bool hasConcreteByte = false;
+
+    size_t i = 0;
+    while (i < pattern.size()) {
+        if (pattern[i] == ' ') {
+            ++i;
+            continue;
+        }
+
+        if (pattern[i] == '?') {
+            signature.bytes.push_back(0);
+            signature.wildcard.push_back(true);
+            i += (i + 1 < pattern.size() && pattern[i + 1] == '?') ? 2 : 1;
+            continue;
+        }
+
+        if (i + 1 >= pattern.size()) {
+            return std::nullopt;
+        }
+
+        int high = HexValue(pattern[i]);
+        int low = HexValue(pattern[i + 1]);
+        if (high < 0 || low < 0) {
+            return std::nullopt;
+        }
+
+        signature.bytes.push_back(static_cast<uint8_t>(high * 16 + low));
+        signature.wildcard.push_back(false);
+        hasConcreteByte = true;
+        i += 2;
+    }
+
+    if (!hasConcreteByte) {
+        return std::nullopt;
+    }
+
+    return signature;
+}
+
+namespace SignatureScanner {
+    std::optional<size_t> Find(std::span<const uint8_t> image, const Signature& signature) {
+        if (signature.bytes.empty() || image.size() < signature.bytes.size()) {
+            return std::nullopt;
+        }
+
+        Anchors anchors = PickAnchors(signature);
+
+#ifdef EMBER_SIMD_X64
+        return CpuFeatures::HasAvx2() ? FindAvx2(image, signature, anchors) : FindSse2(image, signature, anchors);
+#else
+        return FindScalar(image, signature, anchors, 0);
+#endif
+    }
+
+    std::optional<uintptr_t> ResolveRipRelative(std::span<const uint8_t> image, const RipRelativeSignature& target) {
+        auto signature = Signature::Parse(target.pattern);
+        if (!signature) {
+            return std::nullopt;
+        }
+
+        auto match = Find(image, *signature);
+        if (!match || *match + target.displacementOffset + sizeof(int32_t) > image.size()) {
+            return std::nullopt;
+        }
+
+        int32_t displacement = 0;
+        std::memcpy(&displacement, image.data() + *match + target.displacementOffset, sizeof(displacement));
+
+        return static_cast<uintptr_t>(static_cast<int64_t>(*match + target.instructionLength) + displacement);
+    }
+
+    uint64_t HashModuleHeader(std::span<const uint8_t> header) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (uint8_t value : header) {
+            hash ^= value;
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    std::optional<uint32_t> ReadPeTimestamp(std::span<const uint8_t> header) {
+        constexpr size_t PE_OFFSET_FIELD = 0x3C;
+        constexpr size_t TIMESTAMP_OFFSET = 8;     // after the signature, machine and section count
+
+        if (header.size() < PE_OFFSET_FIELD + sizeof(uint32_t) || header[0] != 'M' || header[1] != 'Z') {
+            return std::nullopt;
+        }
+
+        uint32_t peOffset = 0;
+        std::memcpy(&peOffset, header.data() + PE_OFFSET_FIELD, sizeof(peOffset));
+        if (peOffset > header.size() - TIMESTAMP_OFFSET - sizeof(uint32_t)) {
+            return std::nullopt;
+        }
+
+        const uint8_t* pe = header.data() + peOffset;
+        if (pe[0] != 'P' || pe[1] != 'E' || pe[2] != 0 || pe[3] != 0) {
+            return std::nullopt;
+        }
+
+        uint32_t timestamp = 0;
+        std::memcpy(&timestamp, pe + TIMESTAMP_OFFSET, sizeof(timestamp));
+        return timestamp;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// An array-of-bytes pattern such as "48 8B 05 ?? ?? ?? ??", where "??" matches any byte.
+struct Signature {
+    std::vector<uint8_t> bytes;
+    std::vector<bool> wildcard;
+
+    static std::optional<Signature> Parse(std::string_view pattern);
+};
+
+// A signature whose match is an instruction with a RIP-relative 32-bit displacement. The
+// resolved RVA is the address the instruction points at, relative to the image start.
+struct RipRelativeSignature {
+    std::string_view pattern;
+    size_t displacementOffset;
+    size_t instructionLength;
+};
+
+namespace SignatureScanner {
+    // Filters candidates 32 (AVX2) or 16 (SSE2) bytes at a time on two anchor bytes of the
+    // pattern, and only runs the full masked comparison where both anchors match.
+    std::optional<size_t> Find(std::span<const uint8_t> image, const Signature& signature);
+
+    std::optional<uintptr_t> ResolveRipRelative(std::span<const uint8_t> image, const RipRelativeSignature& target);
+
+    uint64_t HashModuleHeader(std::span<const uint8_t> header);
+
+    // TimeDateStamp of the PE file header, if the module's first page holds one.
+    std::optional<uint32_t> ReadPeTimestamp(std::span<const uint8_t> header);
+}
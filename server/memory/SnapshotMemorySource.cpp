@@ -0,0 +1,223 @@
+#include "SnapshotMemorySource.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+
+SnapshotMemorySource::~SnapshotMemorySource() {
+    Unmap();
+}
+
+bool SnapshotMemorySource::Open(const std::string& path) {
+    Unmap();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader))) {
+        Unmap();
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        Unmap();
+        return false;
+    }
+
+    mappedData = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    struct stat fileStat{};
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        Unmap();
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        Unmap();
+        return false;
+    }
+
+    mappedData = static_cast<const uint8_t*>(mapping);
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    if (!mappedData) {
+        Unmap();
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(&header, mappedData, sizeof(header));
+
+    size_t tableEnd = sizeof(FileHeader) + static_cast<size_t>(header.regionCount) * sizeof(FileRegion);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION || tableEnd > mappedSize) {
+        Unmap();
+        return false;
+    }
+
+    moduleBase = static_cast<uintptr_t>(header.moduleBase);
+
+    for (uint32_t i = 0; i < header.regionCount; ++i) {
+        FileRegion region{};
+        std::memcpy(&region, mappedData + sizeof(FileHeader) + i * sizeof(FileRegion), sizeof(region));
+
+        if (region.fileOffset > mappedSize || region.size > mappedSize - region.fileOffset) {
+            Unmap();
+            return false;
+        }
+
+        regions.push_back({static_cast<uintptr_t>(region.address), static_cast<size_t>(region.size), mappedData + region.fileOffset});
+    }
+
+    std::sort(regions.begin(), regions.end(), [](const MappedRegion& a, const MappedRegion& b) {
+        return a.address < b.address;
+    });
+
+    return true;
+}
+
+void SnapshotMemorySource::Unmap() {
+#ifdef _WIN32
+    if (mappedData) {
+        UnmapViewOfFile(mappedData);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+        fileHandle = nullptr;
+    }
+#else
+    if (mappedData) {
+        munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+    }
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+#endif
+
+    mappedData = nullptr;
+    mappedSize = 0;
+    moduleBase = 0;
+    regions.clear();
+}
+
+const SnapshotMemorySource::MappedRegion* SnapshotMemorySource::FindRegion(uintptr_t address, size_t size) const {
+    auto next = std::upper_bound(regions.begin(), regions.end(), address, [](uintptr_t value, const MappedRegion& region) {
+        return value < region.address;
+    });
+
+    if (next == regions.begin()) {
+        return nullptr;
+    }
+
+    const MappedRegion& region = *std::prev(next);
+    if (address - region.address > region.size || size > region.size - (address - region.address)) {
+        return nullptr;
+    }
+
+    return &region;
+}
+
+bool SnapshotMemorySource::ReadBatch(std::span<const MemoryRead> reads) {
+    for (const auto& read : reads) {
+        const MappedRegion* region = FindRegion(read.address, read.size);
+        if (!region) {
+            return false;
+        }
+
+        std::memcpy(read.buffer, region->data + (read.address - region->address), read.size);
+    }
+
+    return true;
+}
+
+std::expected<void, MemoryReaderError> SnapshotMemorySource::Initialize(const std::wstring&) {
+    if (!mappedData) {
+        return std::unexpected(MemoryReaderError::ProcessNotFound);
+    }
+
+    return {};
+}
+
+uintptr_t SnapshotMemorySource::GetModuleBase() const {
+    return moduleBase;
+}
+
+size_t SnapshotMemorySource::GetModuleSize() const {
+    const MappedRegion* region = FindRegion(moduleBase, 0);
+    return region && region->address == moduleBase ? region->size : 0;
+}
+
+bool SnapshotMemorySource::IsInitialized() const {
+    return mappedData != nullptr;
+}
+
+bool SnapshotMemorySource::IsProcessRunning() const {
+    return mappedData != nullptr;
+}
+
+void SnapshotMemorySource::Reset() {}
+
+bool SnapshotMemorySource::Write(const std::string& path, uintptr_t moduleBase, std::span<const SnapshotRange> ranges,
+    std::span<const std::vector<uint8_t>> contents) {
+    if (ranges.size() != contents.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        if (contents[i].size() != ranges[i].size) {
+            return false;
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.regionCount = static_cast<uint32_t>(ranges.size());
+    header.moduleBase = moduleBase;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    uint64_t fileOffset = sizeof(FileHeader) + ranges.size() * sizeof(FileRegion);
+    for (const auto& range : ranges) {
+        FileRegion region{range.address, range.size, fileOffset};
+        file.write(reinterpret_cast<const char*>(&region), sizeof(region));
+        fileOffset += range.size;
+    }
+
+    for (const auto& bytes : contents) {
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "MemorySource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+struct SnapshotRange {
+    uintptr_t address;
+    size_t size;
+};
+
+// Serves reads from a captured dump of the game's memory, mapped read-only. A dump holds the
+// module base plus any number of (address, bytes) regions, so whole pointer chains can be
+// replayed offline at memcpy speed.
+class SnapshotMemorySource {
+private:
+    static constexpr char MAGIC[8] = {'E', 'M', 'B', 'R', 'S', 'N', 'A', 'P'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t regionCount;
+        uint64_t moduleBase;
+    };
+
+    struct FileRegion {
+        uint64_t address;
+        uint64_t size;
+        uint64_t fileOffset;
+    };
+
+    struct MappedRegion {
+        uintptr_t address;
+        size_t size;
+        const uint8_t* data;
+    };
+
+    const uint8_t* mappedData = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+
+    uintptr_t moduleBase = 0;
+    std::vector<MappedRegion> regions;
+
+    const MappedRegion* FindRegion(uintptr_t address, size_t size) const;
+    void Unmap();
+
+public:
+    SnapshotMemorySource() = default;
+
+    SnapshotMemorySource(const SnapshotMemorySource&) = delete;
+    SnapshotMemorySource& operator=(const SnapshotMemorySource&) = delete;
+
+    ~SnapshotMemorySource();
+
+    bool Open(const std::string& path);
+
+    template<typename T>
+    bool ReadMemory(uintptr_t address, T& value) {
+        const MappedRegion* region = FindRegion(address, sizeof(T));
+        if (!region) {
+            return false;
+        }
+
+        std::memcpy(&value, region->data + (address - region->address), sizeof(T));
+        return true;
+    }
+
+    bool ReadBatch(std::span<const MemoryRead> reads);
+
+    // The dump stands in for the whole process, so the name is ignored once a file is open.
+    std::expected<void, MemoryReaderError> Initialize(const std::wstring& processName);
+    uintptr_t GetModuleBase() const;
+    size_t GetModuleSize() const;
+    bool IsInitialized() const;
+    bool IsProcessRunning() const;
+    void Reset();
+
+    static bool Write(const std::string& path, uintptr_t moduleBase, std::span<const SnapshotRange> ranges,
+        std::span<const std::vector<uint8_t>> contents);
+};
+
+// Reads each range from a live source and writes them to a dump SnapshotMemorySource can open.
+template<MemorySource Source>
+bool CaptureSnapshot(Source& source, std::span<const SnapshotRange> ranges, const std::string& path) {
+    std::vector<std::vector<uint8_t>> contents(ranges.size());
+    std::vector<MemoryRead> reads;
+    reads.reserve(ranges.size());
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        contents[i].resize(ranges[i].size);
+        reads.push_back({ranges[i].address, contents[i].data(), ranges[i].size});
+    }
+
+    if (!source.ReadBatch(reads)) {
+        return false;
+    }
+
+    return SnapshotMemorySource::Write(path, source.GetModuleBase(), ranges, contents);
+}
@@ -0,0 +1,348 @@
+#include "WatchList.h"
+#include "MemoryReader.h"
+#include "SnapshotMemorySource.h"
+#include "../core/Log.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace {
+    constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+
+    struct WatchTypeInfo {
+        WatchType type;
+        const char* name;
+        size_t size;
+    };
+
+    constexpr WatchTypeInfo WATCH_TYPES[] = {
+        {WatchType::U8, "u8", 1},
+        {WatchType::I8, "i8", 1},
+        {WatchType::U16, "u16", 2},
+        {WatchType::I16, "i16", 2},
+        {WatchType::U32, "u32", 4},
+        {WatchType::I32, "i32", 4},
+        {WatchType::U64, "u64", 8},
+        {WatchType::I64, "i64", 8},
+        {WatchType::F32, "f32", 4},
+        {WatchType::F64, "f64", 8},
+    };
+
+    const WatchTypeInfo& GetTypeInfo(WatchType type) {
+        return WATCH_TYPES[static_cast<size_t>(type)];
+    }
+
+    std::optional<uintptr_t> ParseOffset(const json& value) {
+        if (value.is_number_unsigned()) {
+            return value.get<uintptr_t>();
+        }
+
+        if (value.is_string()) {
+            try {
+                return static_cast<uintptr_t>(std::stoull(value.get<std::string>(), nullptr, 0));
+            }
+            catch (...) {
+                return std::nullopt;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<WatchEntry> ParseEntry(const json& item) {
+        if (!item.is_object()) {
+            return std::nullopt;
+        }
+
+        WatchEntry entry{};
+        entry.name = item.value("name", "");
+        if (entry.name.empty()) {
+            return std::nullopt;
+        }
+
+        std::string root = item.value("root", "");
+        bool rootFound = false;
+        for (size_t candidate = 0; candidate < PATH_ROOT_COUNT && !rootFound; ++candidate) {
+            if (root == pathRootToString(static_cast<PathRoot>(candidate))) {
+                entry.root = static_cast<PathRoot>(candidate);
+                rootFound = true;
+            }
+        }
+        if (!rootFound) {
+            return std::nullopt;
+        }
+
+        if (item.contains("chain")) {
+            if (!item["chain"].is_array()) {
+                return std::nullopt;
+            }
+            for (const auto& step : item["chain"]) {
+                auto offset = ParseOffset(step);
+                if (!offset) {
+                    return std::nullopt;
+                }
+                entry.chain.push_back(*offset);
+            }
+        }
+
+        auto offset = item.contains("offset") ? ParseOffset(item["offset"]) : std::nullopt;
+        if (!offset) {
+            return std::nullopt;
+        }
+        entry.offset = *offset;
+
+        std::string type = item.value("type", "");
+        auto typeInfo = std::find_if(std::begin(WATCH_TYPES), std::end(WATCH_TYPES),
+            [&](const WatchTypeInfo& info) { return type == info.name; });
+        if (typeInfo == std::end(WATCH_TYPES)) {
+            return std::nullopt;
+        }
+        entry.type = typeInfo->type;
+
+        auto rate = item.find("rateHz");
+        entry.rateHz = rate != item.end() && rate->is_number() ? rate->get<double>() : 1.0;
+
+        return entry;
+    }
+
+    template<typename Raw, typename Stored>
+    std::optional<WatchValue> DecodeAs(const ReadPlan& plan, size_t field) {
+        Raw raw{};
+        if (!plan.Decode(field, raw)) {
+            return std::nullopt;
+        }
+        return WatchValue(static_cast<Stored>(raw));
+    }
+
+    std::optional<WatchValue> DecodeValue(const ReadPlan& plan, size_t field, WatchType type) {
+        switch (type) {
+            case WatchType::U8: return DecodeAs<uint8_t, uint64_t>(plan, field);
+            case WatchType::I8: return DecodeAs<int8_t, int64_t>(plan, field);
+            case WatchType::U16: return DecodeAs<uint16_t, uint64_t>(plan, field);
+            case WatchType::I16: return DecodeAs<int16_t, int64_t>(plan, field);
+            case WatchType::U32: return DecodeAs<uint32_t, uint64_t>(plan, field);
+            case WatchType::I32: return DecodeAs<int32_t, int64_t>(plan, field);
+            case WatchType::U64: return DecodeAs<uint64_t, uint64_t>(plan, field);
+            case WatchType::I64: return DecodeAs<int64_t, int64_t>(plan, field);
+            case WatchType::F32: return DecodeAs<float, double>(plan, field);
+            case WatchType::F64: return DecodeAs<double, double>(plan, field);
+        }
+        return std::nullopt;
+    }
+}
+
+const char* watchTypeToString(WatchType type) {
+    return GetTypeInfo(type).name;
+}
+
+void WatchList::Load() {
+    entries.clear();
+
+    std::ifstream watchFile(FILENAME);
+    if (watchFile) {
+        try {
+            json watchData;
+            watchFile >> watchData;
+
+            for (const auto& item : watchData.value("watches", json::array())) {
+                auto entry = ParseEntry(item);
+                if (!entry) {
+                    log(LogLevel::WARN, "Skipping invalid watch: " + item.dump());
+                    continue;
+                }
+                entries.push_back(std::move(*entry));
+            }
+        }
+        catch (...) {
+            log(LogLevel::WARN, "Invalid watchlist.json, ignoring watches");
+            entries.clear();
+        }
+    }
+
+    Compile();
+
+    if (!entries.empty()) {
+        log(LogLevel::INFO, "Watching " + std::to_string(entries.size()) + " values over " +
+            std::to_string(nodes.size() - PATH_ROOT_COUNT) + " shared pointer steps");
+    }
+}
+
+size_t WatchList::FindOrAddNode(size_t parent, uintptr_t offset) {
+    for (size_t node = PATH_ROOT_COUNT; node < nodes.size(); ++node) {
+        if (nodes[node].parent == parent && nodes[node].offset == offset) {
+            return node;
+        }
+    }
+
+    nodes.push_back({parent, offset, nodes[parent].depth + 1});
+    maxDepth = std::max(maxDepth, nodes.back().depth);
+    return nodes.size() - 1;
+}
+
+void WatchList::Compile() {
+    nodes.clear();
+    compiled.clear();
+    plan = ReadPlan{};
+    maxDepth = 0;
+
+    for (size_t root = 0; root < PATH_ROOT_COUNT; ++root) {
+        nodes.push_back({NO_PARENT, 0, 0});
+    }
+
+    for (const WatchEntry& entry : entries) {
+        size_t node = static_cast<size_t>(entry.root);
+        for (uintptr_t offset : entry.chain) {
+            node = FindOrAddNode(node, offset);
+        }
+
+        double rate = std::clamp(entry.rateHz, MIN_RATE_HZ, MAX_RATE_HZ);
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+
+        size_t field = plan.AddField(node, entry.offset, GetTypeInfo(entry.type).size);
+        compiled.push_back({node, field, interval, {}});
+    }
+
+    plan.Compile();
+
+    values.assign(entries.size(), std::nullopt);
+    nodeAddresses.assign(nodes.size(), 0);
+    nodeNeeded.assign(nodes.size(), false);
+    watchDue.assign(entries.size(), false);
+    blockNeeded.assign(plan.GetBlocks().size(), false);
+}
+
+std::span<const WatchEntry> WatchList::GetEntries() const {
+    return entries;
+}
+
+std::span<const std::optional<WatchValue>> WatchList::GetValues() const {
+    return values;
+}
+
+bool WatchList::IsEmpty() const {
+    return entries.empty();
+}
+
+std::chrono::steady_clock::time_point WatchList::NextDue() const {
+    auto nextDue = std::chrono::steady_clock::time_point::max();
+    for (const CompiledWatch& watch : compiled) {
+        nextDue = std::min(nextDue, watch.lastSampled + watch.interval);
+    }
+    return nextDue;
+}
+
+template<MemorySource Source>
+void WatchList::ReadAll(Source& source) {
+    readSucceeded.assign(reads.size(), true);
+    if (reads.empty() || source.ReadBatch(reads)) {
+        return;
+    }
+
+    for (size_t i = 0; i < reads.size(); ++i) {
+        readSucceeded[i] = source.ReadBatch(std::span<const MemoryRead>(&reads[i], 1));
+    }
+}
+
+template<MemorySource Source>
+bool WatchList::Execute(Source& source, const std::array<uintptr_t, PATH_ROOT_COUNT>& roots,
+    std::chrono::steady_clock::time_point now) {
+    auto blocks = plan.GetBlocks();
+    bool anyDue = false;
+
+    std::fill(nodeNeeded.begin(), nodeNeeded.end(), false);
+    std::fill(blockNeeded.begin(), blockNeeded.end(), false);
+
+    for (size_t i = 0; i < compiled.size(); ++i) {
+        CompiledWatch& watch = compiled[i];
+        watchDue[i] = now - watch.lastSampled >= watch.interval;
+        if (!watchDue[i]) {
+            continue;
+        }
+
+        watch.lastSampled = now;
+        anyDue = true;
+
+        size_t block = plan.GetFieldBlock(watch.field);
+        blockNeeded[block] = true;
+        for (size_t node = blocks[block].chain; node != NO_PARENT && !nodeNeeded[node]; node = nodes[node].parent) {
+            nodeNeeded[node] = true;
+        }
+    }
+
+    if (!anyDue) {
+        return false;
+    }
+
+    for (size_t root = 0; root < PATH_ROOT_COUNT; ++root) {
+        nodeAddresses[root] = roots[root];
+    }
+
+    // One batch per tree level: every pointer at a level only depends on the level above.
+    for (size_t depth = 1; depth <= maxDepth; ++depth) {
+        reads.clear();
+        readTargets.clear();
+
+        for (size_t node = PATH_ROOT_COUNT; node < nodes.size(); ++node) {
+            if (!nodeNeeded[node] || nodes[node].depth != depth) {
+                continue;
+            }
+
+            nodeAddresses[node] = 0;
+            uintptr_t parentAddress = nodeAddresses[nodes[node].parent];
+            if (parentAddress == 0) {
+                continue;
+            }
+
+            reads.push_back({parentAddress + nodes[node].offset, &nodeAddresses[node], sizeof(uintptr_t)});
+            readTargets.push_back(node);
+        }
+
+        ReadAll(source);
+        for (size_t i = 0; i < reads.size(); ++i) {
+            if (!readSucceeded[i]) {
+                nodeAddresses[readTargets[i]] = 0;
+            }
+        }
+    }
+
+    reads.clear();
+    readTargets.clear();
+
+    for (size_t block = 0; block < blocks.size(); ++block) {
+        if (!blockNeeded[block]) {
+            continue;
+        }
+
+        plan.SetBlockValid(block, false);
+        uintptr_t base = nodeAddresses[blocks[block].chain];
+        if (base == 0) {
+            continue;
+        }
+
+        reads.push_back({base + blocks[block].offset, plan.GetBlockData(block), blocks[block].size});
+        readTargets.push_back(block);
+    }
+
+    ReadAll(source);
+    for (size_t i = 0; i < reads.size(); ++i) {
+        plan.SetBlockValid(readTargets[i], readSucceeded[i]);
+    }
+
+    for (size_t i = 0; i < compiled.size(); ++i) {
+        if (watchDue[i]) {
+            values[i] = DecodeValue(plan, compiled[i].field, entries[i].type);
+        }
+    }
+
+    return true;
+}
+
+template bool WatchList::Execute<MemoryReader>(MemoryReader&, const std::array<uintptr_t, PATH_ROOT_COUNT>&,
+    std::chrono::steady_clock::time_point);
+template bool WatchList::Execute<SnapshotMemorySource>(SnapshotMemorySource&, const std::array<uintptr_t, PATH_ROOT_COUNT>&,
+    std::chrono::steady_clock::time_point);
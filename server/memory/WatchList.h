@@ -0,0 +1,99 @@
+#pragma once
+
+#include "MemorySource.h"
+#include "PointerPath.h"
+#include "ReadPlan.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+enum class WatchType {
+    U8, I8, U16, I16, U32, I32, U64, I64, F32, F64
+};
+
+struct WatchEntry {
+    std::string name;
+    PathRoot root;
+    std::vector<uintptr_t> chain;   // dereferenced in turn from the root pointer
+    uintptr_t offset;               // of the value inside the block the chain lands on
+    WatchType type;
+    double rateHz;
+};
+
+using WatchValue = std::variant<int64_t, uint64_t, double>;
+
+const char* watchTypeToString(WatchType type);
+
+// Extra values read by the sampler, defined in watchlist.json rather than in DS3Fields:
+//
+//   {"watches": [{"name": "souls", "root": "GameDataMan", "chain": ["0x10"],
+//                 "offset": "0x74", "type": "u32", "rateHz": 2}]}
+//
+// Chains are merged into a prefix tree, so a prefix shared by several entries is
+// dereferenced once per tick. Each tree level is one batched read, then the values
+// themselves go through a ReadPlan like the built-in fields.
+class WatchList {
+private:
+    static constexpr double MIN_RATE_HZ = 0.1;
+    static constexpr double MAX_RATE_HZ = 60.0;
+
+    struct ChainNode {
+        size_t parent;
+        uintptr_t offset;
+        size_t depth;
+    };
+
+    struct CompiledWatch {
+        size_t node;
+        size_t field;
+        std::chrono::steady_clock::duration interval;
+        std::chrono::steady_clock::time_point lastSampled;
+    };
+
+    std::vector<WatchEntry> entries;
+    std::vector<CompiledWatch> compiled;
+    std::vector<ChainNode> nodes;
+    size_t maxDepth = 0;
+
+    ReadPlan plan;
+    std::vector<std::optional<WatchValue>> values;
+
+    std::vector<uintptr_t> nodeAddresses;
+    std::vector<bool> nodeNeeded;
+    std::vector<bool> watchDue;
+    std::vector<bool> blockNeeded;
+    std::vector<MemoryRead> reads;
+    std::vector<size_t> readTargets;
+    std::vector<bool> readSucceeded;
+
+    size_t FindOrAddNode(size_t parent, uintptr_t offset);
+    void Compile();
+
+    // Fills readSucceeded for reads; one bad pointer must not fail its whole batch.
+    template<MemorySource Source>
+    void ReadAll(Source& source);
+
+public:
+    static constexpr const char* FILENAME = "watchlist.json";
+
+    // Missing file means an empty list; invalid entries are logged and skipped.
+    void Load();
+
+    std::span<const WatchEntry> GetEntries() const;
+    std::span<const std::optional<WatchValue>> GetValues() const;
+    bool IsEmpty() const;
+
+    std::chrono::steady_clock::time_point NextDue() const;
+
+    // Reads every entry due at now. Returns false if nothing was due.
+    template<MemorySource Source>
+    bool Execute(Source& source, const std::array<uintptr_t, PATH_ROOT_COUNT>& roots,
+        std::chrono::steady_clock::time_point now);
+};
@@ -0,0 +1,187 @@
+#include "GameEvents.h"
+#include "GameMonitor.h"
+#include "GameSampler.h"
+#include "../core/Log.h"
+
+GameEventBus g_gameEvents;
+
+static_assert(GameEventBus::INSTANCE_COUNT == MAX_INSTANCES);
+
+void ApplyGameEvent(GameStatus& status, const GameEvent& event) {
+    switch (event.type) {
+        case GameEventType::GameDetected:
+            status.isRunning = true;
+            return;
+        case GameEventType::GameExited:
+            status = GameStatus{};
+            return;
+        case GameEventType::BossFightEntered:
+            status.inBossFight = true;
+            break;
+        case GameEventType::BossFightExited:
+            status.inBossFight = false;
+            break;
+        case GameEventType::Resync:
+            // Carries no status of its own; the subscriber takes Subscription::Initial.
+            return;
+        default:
+            break;
+    }
+
+    status.isRunning = true;
+    status.hasStats = true;
+    status.deaths = event.deaths;
+    status.playtime = event.playtime;
+    status.zoneId = event.zoneId;
+}
+
+GameEventBus::Subscription GameEventBus::Subscribe(size_t instance) {
+    Subscription subscription;
+    if (instance >= INSTANCE_COUNT) {
+        return subscription;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
+        Slot& slot = slots[i];
+        if (slot.claimed) {
+            continue;
+        }
+
+        // A previous owner may have left events behind.
+        slot.transitions.clear();
+        slot.hasLatestStats = false;
+        slot.resync = false;
+
+        slot.claimed = true;
+        slot.instance = static_cast<uint8_t>(instance);
+
+        subscription.bus = this;
+        subscription.slot = i;
+        subscription.initial = statuses[instance];
+        return subscription;
+    }
+
+    return subscription;
+}
+
+void GameEventBus::Release(size_t slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    slots[slot].claimed = false;
+}
+
+void GameEventBus::Publish(GameEvent event) {
+    if (event.instance >= INSTANCE_COUNT) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        event.sequence = nextSequence++;
+        ApplyGameEvent(statuses[event.instance], event);
+
+        for (Slot& slot : slots) {
+            if (!slot.claimed || slot.instance != event.instance) {
+                continue;
+            }
+
+            if (slot.resync) {
+                slot.resyncSequence = event.sequence;
+                slot.resyncStatus = statuses[event.instance];
+            } else if (event.type == GameEventType::StatsChanged) {
+                slot.latestStats = event;
+                slot.hasLatestStats = true;
+            } else if (slot.transitions.size() < TRANSITION_CAPACITY) {
+                slot.transitions.push_back(event);
+            } else {
+                log(LogLevel::WARN, "Game event subscriber fell " + std::to_string(TRANSITION_CAPACITY) +
+                    " transitions behind, replacing them with a resync");
+                slot.transitions.clear();
+                slot.hasLatestStats = false;
+                slot.resync = true;
+                slot.resyncSequence = event.sequence;
+                slot.resyncStatus = statuses[event.instance];
+            }
+        }
+    }
+    cv.notify_all();
+}
+
+GameEventBus::Subscription::~Subscription() {
+    if (bus) {
+        bus->Release(slot);
+    }
+}
+
+GameEventBus::Subscription::Subscription(Subscription&& other) noexcept
+    : bus(other.bus), slot(other.slot), initial(other.initial), pending(std::move(other.pending)) {
+    other.bus = nullptr;
+}
+
+GameEventBus::Subscription& GameEventBus::Subscription::operator=(Subscription&& other) noexcept {
+    if (this != &other) {
+        if (bus) {
+            bus->Release(slot);
+        }
+        bus = other.bus;
+        slot = other.slot;
+        initial = other.initial;
+        pending = std::move(other.pending);
+        other.bus = nullptr;
+    }
+    return *this;
+}
+
+void GameEventBus::Subscription::TakeQueued() {
+    Slot& queued = bus->slots[slot];
+
+    if (queued.resync) {
+        GameEvent resync;
+        resync.sequence = queued.resyncSequence;
+        resync.type = GameEventType::Resync;
+        resync.instance = queued.instance;
+        resync.occurredAt = std::chrono::system_clock::now();
+        pending.push_back(resync);
+
+        // Next takes from the slot only once pending is empty, so the Resync is returned next.
+        initial = queued.resyncStatus;
+        queued.resync = false;
+        return;
+    }
+
+    pending.insert(pending.end(), queued.transitions.begin(), queued.transitions.end());
+    queued.transitions.clear();
+
+    // A transition published after it carries newer values already.
+    if (queued.hasLatestStats) {
+        if (pending.empty() || queued.latestStats.sequence > pending.back().sequence) {
+            pending.push_back(queued.latestStats);
+        }
+        queued.hasLatestStats = false;
+    }
+}
+
+bool GameEventBus::Subscription::Next(GameEvent& event, std::chrono::milliseconds timeout) {
+    if (!bus) {
+        return false;
+    }
+
+    if (pending.empty()) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        Slot& queued = bus->slots[slot];
+
+        std::unique_lock<std::mutex> lock(bus->mutex);
+        if (!queued.HasQueued() && (!g_running || timeout.count() <= 0 ||
+            !bus->cv.wait_until(lock, deadline, [&] { return !g_running || queued.HasQueued(); }))) {
+            return false;
+        }
+        TakeQueued();
+    }
+
+    if (pending.empty()) {
+        return false;
+    }
+    event = pending.front();
+    pending.pop_front();
+    return true;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+enum class GameEventType : uint8_t {
+    GameDetected,
+    GameExited,
+    SessionStarted,
+    StatsChanged,
+    Death,
+    ZoneChanged,
+    BossFightEntered,
+    BossFightExited,
+    Resync              // the subscriber fell behind; see GameEventBus
+};
+
+// What gameMonitorLoop saw change in one instance. Every event but GameDetected and GameExited
+// carries the instance's deaths, playtime and zone as of the event, so a subscriber never has
+// to ask the sampler for them.
+struct GameEvent {
+    uint64_t sequence = 0;      // assigned by GameEventBus::Publish, increasing across instances
+    GameEventType type = GameEventType::GameDetected;
+    uint8_t instance = 0;
+    std::chrono::system_clock::time_point occurredAt{};
+    uint32_t deaths = 0;
+    uint32_t playtime = 0;
+    uint32_t zoneId = 0;        // 0 at the main menu
+    int characterId = -1;       // SessionStarted and Death only
+};
+
+// One instance as its events describe it: the state a subscriber starts from.
+struct GameStatus {
+    bool isRunning = false;
+    bool hasStats = false;
+    uint32_t deaths = 0;
+    uint32_t playtime = 0;
+    uint32_t zoneId = 0;
+    bool inBossFight = false;
+};
+
+void ApplyGameEvent(GameStatus& status, const GameEvent& event);
+
+// Fans the events of gameMonitorLoop out to Discord and the SSE streams, which used to find
+// the same changes again by polling the sampler and comparing with the values they last saw.
+// StatsChanged, published on nearly every progress sample, only replaces the one a
+// subscriber has not taken yet: each carries absolute values, so only the latest matters.
+// Every other event is a state transition and is queued in order, up to TRANSITION_CAPACITY
+// per subscriber. A subscriber that lets that many pile up loses them all: it gets a single
+// Resync instead, after which Subscription::Initial holds the instance's status as of the
+// Resync, and queueing starts again from there.
+// One mutex guards the slots, the instance statuses and the wakeups; there is one publisher
+// and a handful of subscribers, at most tens of events a second.
+class GameEventBus {
+public:
+    static constexpr size_t MAX_SUBSCRIBERS = 16;
+    static constexpr size_t TRANSITION_CAPACITY = 256;
+    static constexpr size_t INSTANCE_COUNT = 8;
+
+private:
+    struct Slot {
+        bool claimed = false;
+        uint8_t instance = 0;
+        std::deque<GameEvent> transitions;  // at most TRANSITION_CAPACITY
+        GameEvent latestStats{};
+        bool hasLatestStats = false;
+
+        // Set when transitions overflowed; nothing else is queued until the subscriber takes it.
+        bool resync = false;
+        uint64_t resyncSequence = 0;
+        GameStatus resyncStatus{};
+
+        bool HasQueued() const { return !transitions.empty() || hasLatestStats || resync; }
+    };
+
+    std::array<Slot, MAX_SUBSCRIBERS> slots;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t nextSequence = 1;
+    std::array<GameStatus, INSTANCE_COUNT> statuses{};
+
+    void Release(size_t slot);
+
+public:
+    // Events of one instance, from the status it had when subscribing onwards.
+    class Subscription {
+    private:
+        GameEventBus* bus = nullptr;
+        size_t slot = 0;
+        GameStatus initial{};
+
+        // Taken from the slot, oldest first. Subscriber thread only.
+        std::deque<GameEvent> pending;
+
+        // Moves what the slot holds into pending. Needs the bus mutex.
+        void TakeQueued();
+
+        friend class GameEventBus;
+
+    public:
+        Subscription() = default;
+        ~Subscription();
+
+        Subscription(Subscription&& other) noexcept;
+        Subscription& operator=(Subscription&& other) noexcept;
+        Subscription(const Subscription&) = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        // False when every subscriber slot was taken.
+        bool IsValid() const { return bus != nullptr; }
+
+        // The instance's status just before the first event this subscription receives, and
+        // once a Resync has been returned, the status as of that Resync.
+        const GameStatus& Initial() const { return initial; }
+
+        // Waits up to timeout for the next event, oldest first; a zero timeout only drains what
+        // is queued. Of several StatsChanged since the last call only the latest is returned.
+        bool Next(GameEvent& event, std::chrono::milliseconds timeout);
+    };
+
+    GameEventBus() = default;
+    GameEventBus(const GameEventBus&) = delete;
+    GameEventBus& operator=(const GameEventBus&) = delete;
+
+    Subscription Subscribe(size_t instance);
+
+    // gameMonitorLoop only.
+    void Publish(GameEvent event);
+};
+
+extern GameEventBus g_gameEvents;
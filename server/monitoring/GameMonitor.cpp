@@ -1,22 +1,62 @@
 #include "GameMonitor.h"
 #include "../core/Log.h"
 #include "../core/Stats.h"
+#include "../core/Trajectory.h"
+#include "../core/ZoneTime.h"
 #include "../core/ZoneNames.h"
 #include "../database/SessionDatabase.h"
-#include "../memory/DS3StatsReader.h"
+#include "GameEvents.h"
+#include "GameSampler.h"
 
+#include <array>
 #include <chrono>
-#include <thread>
+#include <optional>
+#include <vector>
 #include <Windows.h>
 
-std::string g_sessionStartTime;
-int g_startingDeaths = -1;
-int g_lastKnownDeaths = 0;
-int g_lastKnownPlaytime = 0;
-int g_currentCharacterId = -1;
-std::atomic<bool> g_sessionActive = false;
 std::atomic<bool> g_running = true;
-CharacterStats g_lastKnownStats{};
+
+// A trajectory chunk is written once it spans this long, and on every death and session end.
+static constexpr auto TRAJECTORY_CHUNK_SPAN = std::chrono::minutes(1);
+
+// An active session is checkpointed this often, and when it starts; see SessionCheckpoint.
+static constexpr auto CHECKPOINT_INTERVAL = std::chrono::seconds(15);
+
+// Time spent in each zone is added to zone_time this often, and when the session ends.
+static constexpr auto ZONE_TIME_FLUSH_INTERVAL = std::chrono::minutes(1);
+
+// Inventory changes kept while no session is active; a full baseline is about 2000.
+static constexpr size_t MAX_HELD_INVENTORY_EVENTS = 4096;
+
+// Session bookkeeping for one instance slot; instance 0 also keeps player_stats up to date.
+struct InstanceSession {
+    bool wasConnected = false;
+    std::chrono::steady_clock::time_point sessionStartPoint{};
+    bool wasInBossFight = false;
+    bool deathRecorded = false;
+    uint64_t lastSequence = 0;
+
+    std::string sessionStartTime;
+    int startingDeaths = -1;
+    int lastKnownDeaths = 0;
+    int lastKnownPlaytime = 0;
+    int currentCharacterId = -1;
+    bool sessionActive = false;
+    CharacterStats lastKnownStats{};
+    bool hasStats = false;
+    std::chrono::steady_clock::time_point lastCheckpointPoint{};
+
+    TrajectoryEncoder trajectory;
+    std::chrono::system_clock::time_point lastPositionAt{};
+
+    std::vector<InventoryEvent> heldInventory;
+
+    ZoneTimeAccumulator zoneTime;
+    std::chrono::steady_clock::time_point lastZoneTimeFlushPoint{};
+
+    // The instance as subscribers last heard it, to publish only what changed.
+    GameStatus published{};
+};
 
 static std::string WStringToString(const std::wstring& wstr) {
     if (wstr.empty()) return "";
@@ -26,148 +66,372 @@ static std::string WStringToString(const std::wstring& wstr) {
     return result;
 }
 
-void gameMonitorLoop() {
-    DS3StatsReader statsReader;
-    bool wasConnected = false;
-    auto sessionStartPoint = std::chrono::steady_clock::now();
+static std::string InstanceLabel(size_t instance) {
+    return " (instance " + std::to_string(instance) + ")";
+}
 
-    bool wasInBossFight = false;
-    bool deathRecorded = false;
+static void PublishEvent(size_t instance, InstanceSession& session, GameEventType type, const GameStatus& current,
+    int characterId = -1, std::chrono::system_clock::time_point occurredAt = std::chrono::system_clock::now()) {
+    GameEvent event{};
+    event.type = type;
+    event.instance = static_cast<uint8_t>(instance);
+    event.occurredAt = occurredAt;
+    event.deaths = current.deaths;
+    event.playtime = current.playtime;
+    event.zoneId = current.zoneId;
+    event.characterId = characterId;
 
-    while (g_running) {
-        if (!statsReader.IsInitialized()) {
-            auto initResult = statsReader.Initialize();
-
-            if (initResult) {
-                wasConnected = true;
-                sessionStartPoint = std::chrono::steady_clock::now();
-                log(LogLevel::INFO, "Game detected by monitor");
-            } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
-                continue;
-            }
+    ApplyGameEvent(session.published, event);
+    g_gameEvents.Publish(event);
+}
+
+// Boss HP from the HP sample taken with the death, else from the snapshot it arrived with.
+static std::optional<double> BossHpPercent(const HpSample& sample, const GameSnapshot& snapshot) {
+    if (sample.bossMaxHP > 0) {
+        return 100.0 * sample.bossHP / sample.bossMaxHP;
+    }
+    if (snapshot.bossHP && snapshot.bossMaxHP && *snapshot.bossMaxHP > 0) {
+        return 100.0 * *snapshot.bossHP / *snapshot.bossMaxHP;
+    }
+    return std::nullopt;
+}
+
+static void FlushTrajectory(size_t instance, InstanceSession& session) {
+    if (session.trajectory.IsEmpty()) {
+        return;
+    }
+
+    auto data = session.trajectory.GetData();
+
+    TrajectoryChunk chunk{};
+    chunk.instanceId = static_cast<int>(instance);
+    chunk.characterId = session.currentCharacterId;
+    chunk.sessionStart = session.sessionStartTime;
+    chunk.startMs = session.trajectory.GetFirstMs();
+    chunk.endMs = session.trajectory.GetLastMs();
+    chunk.pointCount = static_cast<int>(session.trajectory.GetCount());
+    chunk.data.assign(data.begin(), data.end());
+
+    g_sessionDb.SaveTrajectoryChunk(chunk);
+    session.trajectory.Clear();
+}
+
+static void RecordPosition(size_t instance, InstanceSession& session, const GameSnapshot& snapshot) {
+    if (!snapshot.position || snapshot.positionSampledAt == session.lastPositionAt) {
+        return;
+    }
+    session.lastPositionAt = snapshot.positionSampledAt;
+
+    int64_t timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(snapshot.positionSampledAt.time_since_epoch()).count();
+    session.trajectory.Append({timeMs, snapshot.position->x, snapshot.position->y, snapshot.position->z});
+
+    if (std::chrono::milliseconds(session.trajectory.GetLastMs() - session.trajectory.GetFirstMs()) >= TRAJECTORY_CHUNK_SPAN) {
+        FlushTrajectory(instance, session);
+    }
+}
+
+static const char* InventoryKindName(InventoryChangeKind kind) {
+    switch (kind) {
+        case InventoryChangeKind::Item: return "item";
+        case InventoryChangeKind::Souls: return "souls";
+        case InventoryChangeKind::Equip: return "equip";
+        default: return "unknown";
+    }
+}
+
+// Changes seen before the session starts are held until it does, since the character's
+// baseline usually comes first. Those of a session whose character is unknown are dropped;
+// they would have no owner.
+static void RecordInventory(size_t instance, InstanceSession& session, const std::vector<InventoryEvent>& events) {
+    session.heldInventory.insert(session.heldInventory.end(), events.begin(), events.end());
+
+    if (!session.sessionActive) {
+        if (session.heldInventory.size() > MAX_HELD_INVENTORY_EVENTS) {
+            size_t dropped = session.heldInventory.size() - MAX_HELD_INVENTORY_EVENTS;
+            session.heldInventory.erase(session.heldInventory.begin(), session.heldInventory.begin() + dropped);
         }
+        return;
+    }
+
+    if (session.heldInventory.empty() || session.currentCharacterId <= 0) {
+        session.heldInventory.clear();
+        return;
+    }
+
+    std::vector<InventoryLedgerEntry> entries;
+    entries.reserve(session.heldInventory.size());
+    for (const InventoryEvent& event : session.heldInventory) {
+        InventoryLedgerEntry entry{};
+        entry.characterId = session.currentCharacterId;
+        entry.instanceId = static_cast<int>(instance);
+        entry.kind = InventoryKindName(event.change.kind);
+        entry.itemId = event.change.itemId;
+        entry.slot = event.change.slot;
+        entry.delta = event.change.delta;
+        entry.quantity = event.change.quantity;
+        entry.changedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(event.sampledAt.time_since_epoch()).count();
+        entry.isBaseline = event.change.isBaseline;
+        entries.push_back(std::move(entry));
+    }
+    session.heldInventory.clear();
+
+    g_sessionDb.SaveInventoryChanges(entries);
+}
+
+static void FlushZoneTime(InstanceSession& session) {
+    session.lastZoneTimeFlushPoint = std::chrono::steady_clock::now();
+
+    std::vector<ZoneTimeDelta> deltas;
+    session.zoneTime.Take(deltas);
+    if (deltas.empty() || session.currentCharacterId <= 0) {
+        return;
+    }
+
+    std::vector<ZoneTime> times;
+    times.reserve(deltas.size());
+    for (const ZoneTimeDelta& delta : deltas) {
+        times.push_back({delta.zoneId, delta.timeMs, {}});
+    }
+
+    g_sessionDb.AddZoneTimes(session.currentCharacterId, times);
+}
+
+// Counts only time in game with a known character; the first sample after a pause starts
+// a new interval rather than closing one.
+static void RecordZoneTime(InstanceSession& session, const GameSnapshot& snapshot, uint32_t zoneId) {
+    if (snapshot.gameState != GameState::InGame || session.currentCharacterId <= 0) {
+        session.zoneTime.Pause();
+        return;
+    }
+    session.zoneTime.Sample(zoneId, snapshot.sampledAt);
+
+    if (std::chrono::steady_clock::now() - session.lastZoneTimeFlushPoint >= ZONE_TIME_FLUSH_INTERVAL) {
+        FlushZoneTime(session);
+    }
+}
 
-        if (!statsReader.IsProcessRunning()) {
-            if (wasConnected) {
-                log(LogLevel::INFO, "Game closed");
-
-                if (g_sessionActive) {
-                    auto endPoint = std::chrono::steady_clock::now();
-                    auto durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(endPoint - sessionStartPoint).count();
-                    std::string endTimestamp = Stats::GetCurrentTimestamp();
-
-                    g_sessionDb.SaveSession(
-                        g_sessionStartTime,
-                        endTimestamp,
-                        static_cast<int>(durationMs),
-                        g_startingDeaths,
-                        g_lastKnownDeaths,
-                        g_currentCharacterId
-                    );
-
-                    if (g_currentCharacterId > 0) {
-                        CharacterStatsRecord statsRecord{};
-
-                        statsRecord.level = g_lastKnownStats.level;
-                        statsRecord.vigor = g_lastKnownStats.vigor;
-                        statsRecord.attunement = g_lastKnownStats.attunement;
-                        statsRecord.endurance = g_lastKnownStats.endurance;
-                        statsRecord.vitality = g_lastKnownStats.vitality;
-                        statsRecord.strength = g_lastKnownStats.strength;
-                        statsRecord.dexterity = g_lastKnownStats.dexterity;
-                        statsRecord.intelligence = g_lastKnownStats.intelligence;
-                        statsRecord.faith = g_lastKnownStats.faith;
-                        statsRecord.luck = g_lastKnownStats.luck;
-
-                        g_sessionDb.SaveCharacterStats(g_currentCharacterId, statsRecord);
-                    }
-
-                    g_sessionDb.UpdatePlayerStats(g_lastKnownDeaths, g_lastKnownPlaytime);
-
-                    g_sessionActive = false;
-                    g_startingDeaths = -1;
-                    g_currentCharacterId = -1;
-                }
-
-                wasConnected = false;
+static CharacterStatsRecord ToStatsRecord(const CharacterStats& stats) {
+    CharacterStatsRecord statsRecord{};
+
+    statsRecord.level = stats.level;
+    statsRecord.vigor = stats.vigor;
+    statsRecord.attunement = stats.attunement;
+    statsRecord.endurance = stats.endurance;
+    statsRecord.vitality = stats.vitality;
+    statsRecord.strength = stats.strength;
+    statsRecord.dexterity = stats.dexterity;
+    statsRecord.intelligence = stats.intelligence;
+    statsRecord.faith = stats.faith;
+    statsRecord.luck = stats.luck;
+
+    return statsRecord;
+}
+
+static void CheckpointSession(size_t instance, InstanceSession& session) {
+    session.lastCheckpointPoint = std::chrono::steady_clock::now();
+
+    SessionCheckpoint checkpoint{};
+    checkpoint.instanceId = static_cast<int>(instance);
+    checkpoint.startTime = session.sessionStartTime;
+    checkpoint.durationMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        session.lastCheckpointPoint - session.sessionStartPoint).count());
+    checkpoint.startingDeaths = session.startingDeaths;
+    checkpoint.endingDeaths = session.lastKnownDeaths;
+    checkpoint.characterId = session.currentCharacterId;
+    checkpoint.totalPlaytimeMs = session.lastKnownPlaytime;
+    if (session.hasStats) {
+        checkpoint.stats = ToStatsRecord(session.lastKnownStats);
+    }
+
+    g_sessionDb.CheckpointSession(checkpoint);
+}
+
+static void EndSession(size_t instance, InstanceSession& session) {
+    FlushTrajectory(instance, session);
+    FlushZoneTime(session);
+    session.zoneTime.Reset();
+
+    auto endPoint = std::chrono::steady_clock::now();
+    auto durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(endPoint - session.sessionStartPoint).count();
+    std::string endTimestamp = Stats::GetCurrentTimestamp();
+
+    g_sessionDb.SaveSession(
+        session.sessionStartTime,
+        endTimestamp,
+        static_cast<int>(durationMs),
+        session.startingDeaths,
+        session.lastKnownDeaths,
+        session.currentCharacterId,
+        static_cast<int>(instance)
+    );
+
+    if (session.currentCharacterId > 0) {
+        g_sessionDb.SaveCharacterStats(session.currentCharacterId, ToStatsRecord(session.lastKnownStats));
+    }
+
+    // player_stats is a single row backing /api/stats, which follows instance 0.
+    if (instance == 0) {
+        g_sessionDb.UpdatePlayerStats(session.lastKnownDeaths, session.lastKnownPlaytime);
+    }
+
+    session.sessionActive = false;
+    session.startingDeaths = -1;
+    session.currentCharacterId = -1;
+    session.hasStats = false;
+}
+
+static void ProcessSnapshot(size_t instance, InstanceSession& session, const GameSnapshot& snapshot,
+    const std::vector<HpSample>& hpSamples, const std::vector<InventoryEvent>& inventoryEvents) {
+    if (snapshot.isProcessRunning && !session.wasConnected) {
+        session.wasConnected = true;
+        session.sessionStartPoint = std::chrono::steady_clock::now();
+        log(LogLevel::INFO, "Game detected by monitor" + InstanceLabel(instance));
+        PublishEvent(instance, session, GameEventType::GameDetected, {});
+    }
+
+    if (!snapshot.isProcessRunning) {
+        if (session.wasConnected) {
+            log(LogLevel::INFO, "Game closed" + InstanceLabel(instance));
+
+            if (session.sessionActive) {
+                EndSession(instance, session);
             }
-            statsReader.Reset();
-            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
-            continue;
+
+            session.wasConnected = false;
+            session.wasInBossFight = false;
+            session.heldInventory.clear();
+            PublishEvent(instance, session, GameEventType::GameExited, {});
         }
+        return;
+    }
 
-        auto deathsResult = statsReader.GetDeathCount();
-        auto playtimeResult = statsReader.GetPlayTime();
-
-        if (deathsResult && playtimeResult) {
-            if (!g_sessionActive && *playtimeResult > 0) {
-                g_sessionStartTime = Stats::GetCurrentTimestamp();
-                g_startingDeaths = *deathsResult;
-                g_lastKnownDeaths = *deathsResult;
-                g_lastKnownPlaytime = *playtimeResult;
-
-                auto nameResult = statsReader.GetCharacterName();
-                auto classResult = statsReader.GetClass();
-
-                if (nameResult && classResult) {
-                    std::string charName = WStringToString(*nameResult);
-                    g_currentCharacterId = g_sessionDb.GetOrCreateCharacter(charName, *classResult);
-                    log(LogLevel::INFO, "Character: " + charName + " (ID: " + std::to_string(g_currentCharacterId) + ")");
-                } else {
-                    g_currentCharacterId = -1;
-                    log(LogLevel::WARN, "Could not read character info");
-                }
-
-                g_sessionActive = true;
-                sessionStartPoint = std::chrono::steady_clock::now();
-                log(LogLevel::INFO, "Session started with " + std::to_string(g_startingDeaths) + " deaths");
-            }
-            if (g_sessionActive && *playtimeResult > 0) {
-                g_lastKnownDeaths = *deathsResult;
-                g_lastKnownPlaytime = *playtimeResult;
-                
-                if (auto stats = statsReader.GetCharacterStats()) {
-					g_lastKnownStats = *stats;
-                }
-            }
+    if (!snapshot.deaths || !snapshot.playtime) {
+        session.zoneTime.Pause();
+        return;
+    }
 
-            bool inBossFight = false;
-            uint32_t currentZoneId = 0;
-            int32_t playerHP = 1;
+    uint32_t deaths = *snapshot.deaths;
+    uint32_t playtime = *snapshot.playtime;
 
-            auto bossFightResult = statsReader.GetInBossFight();
-            if (bossFightResult) {
-                inBossFight = *bossFightResult;
-            }
+    bool inBossFight = snapshot.inBossFight.value_or(false);
+    uint32_t currentZoneId = snapshot.playRegion.value_or(0);
 
-            auto zoneResult = statsReader.GetPlayRegion();
-            if (zoneResult) {
-                currentZoneId = *zoneResult;
-            }
+    GameStatus current{};
+    current.isRunning = true;
+    current.hasStats = true;
+    current.deaths = deaths;
+    current.playtime = playtime;
+    current.zoneId = currentZoneId;
+    current.inBossFight = inBossFight;
 
-            auto hpResult = statsReader.GetPlayerHP();
-            if (hpResult) {
-                playerHP = *hpResult;
-            }
+    if (!session.sessionActive && playtime > 0) {
+        session.sessionStartTime = Stats::GetCurrentTimestamp();
+        session.startingDeaths = deaths;
+        session.lastKnownDeaths = deaths;
+        session.lastKnownPlaytime = playtime;
 
-            if (inBossFight && !wasInBossFight) {
-                log(LogLevel::INFO, "Entered boss fight: " + GetZoneName(currentZoneId));
-            }
+        if (snapshot.characterName && snapshot.characterClass) {
+            std::string charName = WStringToString(*snapshot.characterName);
+            session.currentCharacterId = g_sessionDb.GetOrCreateCharacter(charName, *snapshot.characterClass);
+            log(LogLevel::INFO, "Character: " + charName + " (ID: " + std::to_string(session.currentCharacterId) + ")" + InstanceLabel(instance));
+        } else {
+            session.currentCharacterId = -1;
+            log(LogLevel::WARN, "Could not read character info" + InstanceLabel(instance));
+        }
 
-            if (playerHP <= 0 && !deathRecorded && currentZoneId != 0 && g_currentCharacterId > 0) {
-                std::string zoneName = GetZoneName(currentZoneId);
-                g_sessionDb.SaveDeath(currentZoneId, zoneName, g_currentCharacterId, inBossFight);
-                deathRecorded = true;
+        session.sessionActive = true;
+        session.sessionStartPoint = std::chrono::steady_clock::now();
+        log(LogLevel::INFO, "Session started with " + std::to_string(session.startingDeaths) + " deaths" + InstanceLabel(instance));
+        PublishEvent(instance, session, GameEventType::SessionStarted, current, session.currentCharacterId);
+        CheckpointSession(instance, session);
+        session.lastZoneTimeFlushPoint = session.sessionStartPoint;
+    }
+    if (session.sessionActive && playtime > 0) {
+        session.lastKnownDeaths = deaths;
+        session.lastKnownPlaytime = playtime;
+
+        if (snapshot.characterStats) {
+            session.lastKnownStats = *snapshot.characterStats;
+            session.hasStats = true;
+        }
+
+        RecordPosition(instance, session, snapshot);
+        RecordZoneTime(session, snapshot, currentZoneId);
+
+        if (std::chrono::steady_clock::now() - session.lastCheckpointPoint >= CHECKPOINT_INTERVAL) {
+            CheckpointSession(instance, session);
+        }
+    }
+
+    RecordInventory(instance, session, inventoryEvents);
+
+    if (!session.published.hasStats || currentZoneId != session.published.zoneId) {
+        PublishEvent(instance, session, GameEventType::ZoneChanged, current);
+    }
+
+    if (inBossFight && !session.wasInBossFight) {
+        log(LogLevel::INFO, "Entered boss fight: " + GetZoneName(currentZoneId) + InstanceLabel(instance));
+        PublishEvent(instance, session, GameEventType::BossFightEntered, current);
+    } else if (!inBossFight && session.wasInBossFight) {
+        PublishEvent(instance, session, GameEventType::BossFightExited, current);
+    }
+
+    for (const HpSample& sample : hpSamples) {
+        if (sample.hp <= 0 && !session.deathRecorded && currentZoneId != 0 && session.currentCharacterId > 0) {
+            std::string zoneName = GetZoneName(currentZoneId);
+            g_sessionDb.SaveDeath(currentZoneId, zoneName, session.currentCharacterId, inBossFight, sample.sampledAt,
+                static_cast<int>(instance), BossHpPercent(sample, snapshot));
+            session.deathRecorded = true;
+            PublishEvent(instance, session, GameEventType::Death, current, session.currentCharacterId, sample.sampledAt);
+
+            // Written now so the death's position can be looked up right away.
+            FlushTrajectory(instance, session);
+        }
+
+        if (sample.hp > 0 && session.deathRecorded) {
+            session.deathRecorded = false;
+        }
+    }
+
+    if (deaths != session.published.deaths || playtime != session.published.playtime) {
+        PublishEvent(instance, session, GameEventType::StatsChanged, current);
+    }
+
+    session.wasInBossFight = inBossFight;
+}
+
+// One task follows every instance: it wakes when any of them publishes and handles only
+// the instances whose snapshot changed. Being one task, its database writes stay on one thread.
+Task gameMonitorLoop() {
+    std::array<InstanceSession, MAX_INSTANCES> sessions{};
+    uint64_t updateCount = 0;
+    std::vector<HpSample> hpSamples;
+    std::vector<InventoryEvent> inventoryEvents;
+
+    while (g_running) {
+        updateCount = co_await GameSampler::NextAnyUpdate(updateCount, std::chrono::milliseconds(1500));
+
+        for (size_t instance = 0; instance < MAX_INSTANCES; ++instance) {
+            GameSampler& sampler = g_gameSamplers[instance];
+            InstanceSession& session = sessions[instance];
+
+            auto snapshot = sampler.Latest();
+            if (snapshot->sequence == session.lastSequence) {
+                continue;
             }
+            session.lastSequence = snapshot->sequence;
 
-            if (playerHP > 0 && deathRecorded) {
-                deathRecorded = false;
+            // Every HP change since the last snapshot, so a death and respawn between two
+            // snapshots is still seen and dated when it happened.
+            hpSamples.clear();
+            HpSample hpSample{};
+            while (sampler.GetHpSampler().Pop(hpSample)) {
+                hpSamples.push_back(hpSample);
             }
 
-            wasInBossFight = inBossFight;
-        }
+            sampler.TakeInventoryEvents(inventoryEvents);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            ProcessSnapshot(instance, session, *snapshot, hpSamples, inventoryEvents);
+        }
     }
 }
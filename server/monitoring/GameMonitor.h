@@ -1,12 +1,10 @@
 #pragma once
 
+#include "../core/Executor.h"
+
 #include <atomic>
-#include <string>
 
-extern std::string g_sessionStartTime;
-extern int g_startingDeaths;
-extern int g_lastKnownDeaths;
-extern std::atomic<bool> g_sessionActive;
 extern std::atomic<bool> g_running;
 
-void gameMonitorLoop();
+// Spawned on g_executor; returns once g_running is cleared.
+Task gameMonitorLoop();
@@ -0,0 +1,397 @@
+#include "GameSampler.h"
+#include "GameMonitor.h"
+#include "../core/Settings.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+std::array<GameSampler, MAX_INSTANCES> g_gameSamplers;
+GameSampler& g_gameSampler = g_gameSamplers[0];
+
+AsyncSignal GameSampler::anyUpdate;
+
+GameSampler::GameSampler() : latest(std::make_shared<const GameSnapshot>()) {}
+
+template<typename T>
+static std::optional<T> ToOptional(const std::expected<T, MemoryReaderError>& value) {
+    return value ? std::optional<T>(*value) : std::nullopt;
+}
+
+static std::chrono::nanoseconds ThreadCpuTime() {
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return {};
+    }
+
+    auto toTicks = [](const FILETIME& time) {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return std::chrono::nanoseconds((toTicks(kernelTime) + toTicks(userTime)) * 100);
+#else
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
+
+// Exit is reported by the instance manager, so an attached reader is not re-checked per tick.
+bool GameSampler::Attach() {
+    if (statsReader.IsInitialized()) {
+        return true;
+    }
+
+    return statsReader.Initialize().has_value();
+}
+
+void GameSampler::SampleGroup(FieldGroup group) {
+    switch (group) {
+        case FieldGroup::Vitals:
+            statsReader.Refresh<DS3Fields::BossFight, DS3Fields::PlayerHP>();
+            current.inBossFight = ToOptional(statsReader.GetInBossFight());
+            current.playerHP = ToOptional(statsReader.GetPlayerHP());
+            {
+                uintptr_t playerHpAddress = statsReader.GetFieldAddress<DS3Fields::PlayerHP>().value_or(0);
+                hpSampler.SetAddress(playerHpAddress);
+                SampleBoss(playerHpAddress);
+            }
+            break;
+
+        case FieldGroup::Progress:
+            statsReader.Refresh<DS3Fields::DeathCount, DS3Fields::PlayTime, DS3Fields::PlayRegion>();
+            current.deaths = ToOptional(statsReader.GetDeathCount());
+            current.playtime = ToOptional(statsReader.GetPlayTime());
+            current.playRegion = ToOptional(statsReader.GetPlayRegion());
+            break;
+
+        case FieldGroup::Character:
+            statsReader.Refresh<DS3Fields::CharacterName, DS3Fields::CharacterClass, DS3Fields::Level>();
+            current.characterName = ToOptional(statsReader.GetCharacterName());
+            current.characterClass = ToOptional(statsReader.GetClass());
+            current.characterStats = ToOptional(statsReader.GetCharacterStats());
+            break;
+
+        case FieldGroup::Position:
+            if (g_settings.trajectorySampleRateHz.load(std::memory_order_relaxed) > 0) {
+                statsReader.Refresh<DS3Fields::PositionX, DS3Fields::PositionY, DS3Fields::PositionZ>();
+                current.position = ToOptional(statsReader.GetPlayerPosition());
+                current.positionSampledAt = std::chrono::system_clock::now();
+            } else {
+                current.position = std::nullopt;
+            }
+            break;
+
+        case FieldGroup::Inventory:
+            SampleInventory();
+            break;
+
+        case FieldGroup::Flags:
+            flagChanges.clear();
+            if (FollowCharacter() && flagTracker.Poll(statsReader.GetSource(), statsReader.GetEventFlagRegion().value_or(0), flagChanges)) {
+                RecordFlagChanges();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// The character list is only walked during a fight; outside one the cached boss is dropped.
+void GameSampler::SampleBoss(uintptr_t playerHpAddress) {
+    std::optional<BossHealth> boss;
+    if (current.inBossFight.value_or(false)) {
+        statsReader.Refresh<DS3Fields::CharacterListBegin, DS3Fields::CharacterListEnd>();
+        auto characters = statsReader.GetCharacterList();
+        if (characters) {
+            boss = bossTracker.Poll(statsReader.GetSource(), characters->begin, characters->end, playerHpAddress);
+        }
+    } else {
+        bossTracker.Reset();
+    }
+
+    current.bossHP = boss ? std::optional<int32_t>(boss->hp) : std::nullopt;
+    current.bossMaxHP = boss ? std::optional<int32_t>(boss->maxHP) : std::nullopt;
+    hpSampler.SetBossAddress(bossTracker.GetHpAddress());
+}
+
+void GameSampler::RecordFlagChanges() {
+    if (flagChanges.empty()) {
+        return;
+    }
+
+    auto sampledAt = std::chrono::system_clock::now();
+
+    std::lock_guard<std::mutex> lock(flagEventsMutex);
+    for (const EventFlagChange& change : flagChanges) {
+        flagEvents.push_back({nextFlagEventId++, sampledAt, change.flag, change.set});
+    }
+    while (flagEvents.size() > MAX_FLAG_EVENTS) {
+        flagEvents.pop_front();
+    }
+}
+
+// Read by each tracker that diffs one character's memory, right before it polls, so a save
+// loaded between two Character samples is never diffed against the previous one. A name
+// that cannot be read (a load screen) is not a change of character. False while unknown.
+bool GameSampler::FollowCharacter() {
+    statsReader.Refresh<DS3Fields::CharacterName>();
+    auto name = statsReader.GetCharacterName();
+    if (!name) {
+        return false;
+    }
+
+    if (name != trackedCharacter) {
+        trackedCharacter = *name;
+        inventoryTracker.Reset();
+        flagTracker.Reset();
+    }
+    return true;
+}
+
+void GameSampler::SampleInventory() {
+    // Not read outside the game (load screens, character select), but the baseline is kept:
+    // what changed across a death or warp load shows up on the next poll. FollowCharacter
+    // starts a new baseline when another character is loaded.
+    if ((mode != SamplingMode::Exploring && mode != SamplingMode::Combat) || !FollowCharacter()) {
+        return;
+    }
+
+    inventoryChanges.clear();
+
+    statsReader.Refresh<DS3Fields::Souls, DS3Fields::EquippedItems>();
+    if (auto souls = statsReader.GetSouls()) {
+        inventoryTracker.UpdateSouls(*souls, inventoryChanges);
+    }
+    if (auto equipped = statsReader.GetEquippedItems()) {
+        inventoryTracker.UpdateEquipment(*equipped, inventoryChanges);
+    }
+    inventoryTracker.PollItems(statsReader.GetSource(), statsReader.GetInventoryRegion().value_or(0), inventoryChanges);
+
+    RecordInventoryChanges();
+}
+
+void GameSampler::RecordInventoryChanges() {
+    if (inventoryChanges.empty()) {
+        return;
+    }
+
+    auto sampledAt = std::chrono::system_clock::now();
+
+    std::lock_guard<std::mutex> lock(inventoryEventsMutex);
+    for (const InventoryChange& change : inventoryChanges) {
+        pendingInventoryEvents.push_back({sampledAt, change});
+    }
+    if (pendingInventoryEvents.size() > MAX_PENDING_INVENTORY_EVENTS) {
+        size_t dropped = pendingInventoryEvents.size() - MAX_PENDING_INVENTORY_EVENTS;
+        pendingInventoryEvents.erase(pendingInventoryEvents.begin(), pendingInventoryEvents.begin() + dropped);
+    }
+}
+
+void GameSampler::Publish(GameSnapshot snapshot) {
+    snapshot.sequence = ++sequence;
+    snapshot.sampledAt = std::chrono::steady_clock::now();
+
+    latest.store(std::make_shared<const GameSnapshot>(std::move(snapshot)), std::memory_order_release);
+    NotifyWaiters();
+}
+
+void GameSampler::Start(const WatchList& loadedWatchList) {
+    watchList = loadedWatchList;
+    watches = std::make_shared<const std::vector<WatchEntry>>(watchList.GetEntries().begin(), watchList.GetEntries().end());
+    current.watches = watches;
+    lastStepAt = std::chrono::steady_clock::now();
+}
+
+void GameSampler::SetTargetProcess(MemoryReader::ProcessId processId) {
+    targetProcess.store(processId, std::memory_order_release);
+    hpSampler.SetProcess(processId);
+}
+
+MemoryReader::ProcessId GameSampler::GetTargetProcess() const {
+    return targetProcess.load(std::memory_order_acquire);
+}
+
+HpSampler& GameSampler::GetHpSampler() {
+    return hpSampler;
+}
+
+std::chrono::steady_clock::time_point GameSampler::Step() {
+    auto now = std::chrono::steady_clock::now();
+    auto cpuStart = ThreadCpuTime();
+
+    MemoryReader::ProcessId processId = targetProcess.load(std::memory_order_acquire);
+    if (processId != boundProcess) {
+        // Bound, released or rebound: sample again right away so consumers see it without waiting a tick.
+        boundProcess = processId;
+        statsReader.Reset();
+        statsReader.GetSource().SetTargetProcess(processId);
+        flagTracker.Reset();
+        bossTracker.Reset();
+        inventoryTracker.Reset();
+        trackedCharacter.reset();
+        lastSampled.fill({});
+    }
+
+    std::array<bool, FIELD_GROUP_COUNT> due{};
+    bool anyDue = false;
+    for (size_t group = 0; group < FIELD_GROUP_COUNT; ++group) {
+        due[group] = now - lastSampled[group] >= SamplingPolicy::GetInterval(mode, static_cast<FieldGroup>(group));
+        anyDue = anyDue || due[group];
+    }
+
+    bool watchesDue = current.isProcessRunning && !watchList.IsEmpty() && now >= watchList.NextDue();
+    anyDue = anyDue || watchesDue;
+
+    if (anyDue) {
+        if (boundProcess == 0 || !Attach()) {
+            current = GameSnapshot{};
+            current.watches = watches;
+            peakHP = 0;
+            peakHPCharacter.reset();
+            hpSampler.SetAddress(0);
+            hpSampler.SetBossAddress(0);
+            flagTracker.Reset();
+            bossTracker.Reset();
+            inventoryTracker.Reset();
+            trackedCharacter.reset();
+            lastSampled.fill(now);
+        } else {
+            current.isProcessRunning = true;
+
+            // Once per tick: outside the game, fields behind the missing pointer fail from the
+            // reader's cache, so the groups below cost next to nothing until it comes back.
+            current.gameState = statsReader.GetGameState();
+            current.buildTimestamp = statsReader.GetBuildTimestamp();
+
+            // A probe that saw the chains move hands HpSampler the new address now, rather
+            // than on the next Vitals read, which is a second away in Menu mode.
+            if (statsReader.GetGeneration() != hpAddressGeneration) {
+                hpSampler.SetAddress(statsReader.GetFieldAddress<DS3Fields::PlayerHP>().value_or(0));
+                hpAddressGeneration = statsReader.GetGeneration();
+            }
+
+            for (size_t group = 0; group < FIELD_GROUP_COUNT; ++group) {
+                if (!due[group]) {
+                    continue;
+                }
+
+                SampleGroup(static_cast<FieldGroup>(group));
+                lastSampled[group] = now;
+
+                // The name reads as missing through load screens, so only another character resets the peak.
+                if (current.characterName && !current.characterName->empty() && current.characterName != peakHPCharacter) {
+                    peakHPCharacter = current.characterName;
+                    peakHP = 0;
+                }
+            }
+
+            if (current.playerHP) {
+                peakHP = std::max(peakHP, *current.playerHP);
+            }
+
+            if (watchesDue) {
+                const std::array<uintptr_t, PATH_ROOT_COUNT> roots = {
+                    statsReader.GetRootAddress(PathRoot::GameDataMan).value_or(0),
+                    statsReader.GetRootAddress(PathRoot::WorldChrMan).value_or(0),
+                    statsReader.GetRootAddress(PathRoot::EventFlagMan).value_or(0)
+                };
+
+                if (watchList.Execute(statsReader.GetSource(), roots, now)) {
+                    current.watchValues.assign(watchList.GetValues().begin(), watchList.GetValues().end());
+                }
+            }
+        }
+
+        current.mode = SamplingPolicy::Classify(current.isProcessRunning, current.gameState, current.inBossFight,
+            current.playerHP, peakHP);
+        Publish(current);
+    }
+
+    auto wallTime = std::chrono::steady_clock::now();
+    auto cpuTime = ThreadCpuTime();
+    {
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        SamplingModeMetrics& modeMetrics = metrics.modes[static_cast<size_t>(mode)];
+        modeMetrics.wallTime += wallTime - lastStepAt;
+        modeMetrics.cpuTime += cpuTime - cpuStart;
+
+        if (anyDue) {
+            ++modeMetrics.ticks;
+            for (size_t group = 0; group < FIELD_GROUP_COUNT; ++group) {
+                modeMetrics.groupSamples[group] += due[group] ? 1 : 0;
+            }
+        }
+
+        metrics.currentMode = current.mode;
+    }
+    lastStepAt = wallTime;
+
+    mode = current.mode;
+
+    // An unbound slot sleeps until the instance manager binds it and wakes its job.
+    if (boundProcess == 0) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+
+    auto nextDue = std::chrono::steady_clock::time_point::max();
+    for (size_t group = 0; group < FIELD_GROUP_COUNT; ++group) {
+        nextDue = std::min(nextDue, lastSampled[group] + SamplingPolicy::GetInterval(mode, static_cast<FieldGroup>(group)));
+    }
+
+    if (current.isProcessRunning) {
+        nextDue = std::min(nextDue, watchList.NextDue());
+    }
+
+    return nextDue;
+}
+
+void GameSampler::NotifyWaiters() {
+    {
+        std::lock_guard<std::mutex> lock(updateMutex);
+    }
+    updateCv.notify_all();
+
+    anyUpdate.Notify();
+}
+
+std::shared_ptr<const GameSnapshot> GameSampler::Latest() const {
+    return latest.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const GameSnapshot> GameSampler::WaitForUpdate(uint64_t lastSequence, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(updateMutex);
+    updateCv.wait_for(lock, timeout, [&] {
+        return !g_running || Latest()->sequence != lastSequence;
+    });
+
+    return Latest();
+}
+
+AsyncSignal::Awaiter GameSampler::NextAnyUpdate(uint64_t lastCount, std::chrono::milliseconds timeout) {
+    return anyUpdate.Wait(g_executor, lastCount, timeout);
+}
+
+SamplerMetrics GameSampler::GetMetrics() const {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    return metrics;
+}
+
+std::vector<EventFlagEvent> GameSampler::GetFlagEvents(uint64_t afterId) const {
+    std::lock_guard<std::mutex> lock(flagEventsMutex);
+
+    auto first = std::upper_bound(flagEvents.begin(), flagEvents.end(), afterId,
+        [](uint64_t id, const EventFlagEvent& event) { return id < event.id; });
+    return std::vector<EventFlagEvent>(first, flagEvents.end());
+}
+
+void GameSampler::TakeInventoryEvents(std::vector<InventoryEvent>& events) {
+    std::lock_guard<std::mutex> lock(inventoryEventsMutex);
+    events.swap(pendingInventoryEvents);
+    pendingInventoryEvents.clear();
+}
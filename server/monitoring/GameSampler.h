@@ -0,0 +1,190 @@
+#pragma once
+
+#include "HpSampler.h"
+#include "SamplingPolicy.h"
+#include "../core/Executor.h"
+#include "../memory/BossTracker.h"
+#include "../memory/DS3StatsReader.h"
+#include "../memory/EventFlags.h"
+#include "../memory/InventoryTracker.h"
+#include "../memory/WatchList.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct GameSnapshot {
+    uint64_t sequence = 0;
+    std::chrono::steady_clock::time_point sampledAt{};
+    bool isProcessRunning = false;
+    SamplingMode mode = SamplingMode::NotRunning;
+    GameState gameState = GameState::Unknown;
+
+    // PE timestamp of the attached game, which identifies its build.
+    std::optional<uint32_t> buildTimestamp;
+
+    std::optional<uint32_t> deaths;
+    std::optional<uint32_t> playtime;
+    std::optional<uint32_t> playRegion;
+    std::optional<bool> inBossFight;
+    std::optional<int32_t> playerHP;
+    std::optional<int32_t> bossHP;      // during a boss fight, once BossTracker has found the boss
+    std::optional<int32_t> bossMaxHP;
+
+    // Only read while trajectories are recorded; positionSampledAt dates it for the trajectory.
+    std::optional<PlayerPosition> position;
+    std::chrono::system_clock::time_point positionSampledAt{};
+
+    std::optional<std::wstring> characterName;
+    std::optional<uint8_t> characterClass;
+    std::optional<CharacterStats> characterStats;
+
+    // watchlist.json entries, shared by every snapshot, and their latest values in the same order.
+    std::shared_ptr<const std::vector<WatchEntry>> watches;
+    std::vector<std::optional<WatchValue>> watchValues;
+};
+
+struct SamplingModeMetrics {
+    std::chrono::nanoseconds wallTime{};
+    std::chrono::nanoseconds cpuTime{};
+    uint64_t ticks = 0;
+    std::array<uint64_t, FIELD_GROUP_COUNT> groupSamples{};
+};
+
+struct SamplerMetrics {
+    SamplingMode currentMode = SamplingMode::NotRunning;
+    std::array<SamplingModeMetrics, SAMPLING_MODE_COUNT> modes{};
+};
+
+// A flag that flipped between two reads of the event flag region.
+struct EventFlagEvent {
+    uint64_t id = 0;
+    std::chrono::system_clock::time_point sampledAt{};
+    uint32_t flag = 0;
+    bool set = false;
+};
+
+// A change to souls, an item slot or an equip slot, dated by the poll that saw it.
+struct InventoryEvent {
+    std::chrono::system_clock::time_point sampledAt{};
+    InventoryChange change{};
+};
+
+// Upper bound on game instances tracked at once; each one is a GameSampler slot.
+constexpr size_t MAX_INSTANCES = 8;
+
+// Owns the DS3StatsReader for one game instance. Every consumer reads the latest immutable
+// snapshot instead of touching the game, so memory-read load does not grow with consumers.
+// Each field group is re-read at the rate SamplingPolicy gives for the current mode, and a
+// snapshot is published whenever any group was sampled.
+class GameSampler {
+private:
+    std::atomic<std::shared_ptr<const GameSnapshot>> latest;
+    uint64_t sequence = 0;
+
+    std::mutex updateMutex;
+    std::condition_variable updateCv;
+
+    // Bumped on every publish by any instance, for consumers that follow all of them.
+    static AsyncSignal anyUpdate;
+
+    SamplerMetrics metrics;
+    mutable std::mutex metricsMutex;
+
+    static constexpr size_t MAX_FLAG_EVENTS = 1024;
+    std::deque<EventFlagEvent> flagEvents;
+    uint64_t nextFlagEventId = 1;
+    mutable std::mutex flagEventsMutex;
+
+    // Waiting for gameMonitorLoop, which writes them to the inventory ledger.
+    static constexpr size_t MAX_PENDING_INVENTORY_EVENTS = 4096;
+    std::vector<InventoryEvent> pendingInventoryEvents;
+    std::mutex inventoryEventsMutex;
+
+    std::atomic<MemoryReader::ProcessId> targetProcess{0};
+    HpSampler hpSampler;
+
+    // Touched only by Step, which never runs on two threads at once.
+    DS3StatsReader statsReader;
+    WatchList watchList;
+    EventFlagTracker flagTracker;
+    BossTracker bossTracker;
+    InventoryTracker inventoryTracker;
+    std::vector<EventFlagChange> flagChanges;
+    std::vector<InventoryChange> inventoryChanges;
+    std::shared_ptr<const std::vector<WatchEntry>> watches;
+    MemoryReader::ProcessId boundProcess = 0;
+    GameSnapshot current{};
+    SamplingMode mode = SamplingMode::NotRunning;
+    std::array<std::chrono::steady_clock::time_point, FIELD_GROUP_COUNT> lastSampled{};
+    std::chrono::steady_clock::time_point lastStepAt{};
+
+    // Reader generation the address last handed to hpSampler was resolved in.
+    uint64_t hpAddressGeneration = 0;
+
+    // Highest HP seen for the current character; low HP is judged against it since max HP is not read.
+    int32_t peakHP = 0;
+    std::optional<std::wstring> peakHPCharacter;
+
+    // The character the inventory and event flag baselines belong to.
+    std::optional<std::wstring> trackedCharacter;
+
+    bool Attach();
+    void SampleGroup(FieldGroup group);
+    void SampleBoss(uintptr_t playerHpAddress);
+    void RecordFlagChanges();
+    bool FollowCharacter();
+    void SampleInventory();
+    void RecordInventoryChanges();
+    void Publish(GameSnapshot snapshot);
+
+public:
+    GameSampler();
+
+    GameSampler(const GameSampler&) = delete;
+    GameSampler& operator=(const GameSampler&) = delete;
+
+    // Called once before the first Step with the shared, already loaded watch list.
+    void Start(const WatchList& loadedWatchList);
+
+    // Binds the slot to one game process; 0 releases it. Takes effect on the next Step.
+    void SetTargetProcess(MemoryReader::ProcessId processId);
+    MemoryReader::ProcessId GetTargetProcess() const;
+
+    // Samples whatever is due; returns when something is next due. Run by SamplerPool.
+    std::chrono::steady_clock::time_point Step();
+
+    HpSampler& GetHpSampler();
+
+    std::shared_ptr<const GameSnapshot> Latest() const;
+    std::shared_ptr<const GameSnapshot> WaitForUpdate(uint64_t lastSequence, std::chrono::milliseconds timeout);
+
+    // co_await from a g_executor task: resumes once any instance has published since
+    // lastCount, and yields the count to pass on the next call.
+    static AsyncSignal::Awaiter NextAnyUpdate(uint64_t lastCount, std::chrono::milliseconds timeout);
+
+    // Releases every waiter, used once g_running is cleared.
+    void NotifyWaiters();
+
+    SamplerMetrics GetMetrics() const;
+
+    // Flag flips recorded after afterId, oldest first; only the last MAX_FLAG_EVENTS are kept.
+    std::vector<EventFlagEvent> GetFlagEvents(uint64_t afterId) const;
+
+    // Replaces events with the inventory changes seen since the last call, oldest first. If they
+    // are not taken, only the last MAX_PENDING_INVENTORY_EVENTS are kept. gameMonitorLoop only.
+    void TakeInventoryEvents(std::vector<InventoryEvent>& events);
+};
+
+// Slot 0 is the first game found and the one Discord and the unprefixed routes follow.
+extern std::array<GameSampler, MAX_INSTANCES> g_gameSamplers;
+extern GameSampler& g_gameSampler;
@@ -0,0 +1,93 @@
+#include "HpSampler.h"
+#include "../memory/DS3StatsReader.h"
+
+#include <cstddef>
+#include <span>
+
+void HpSampler::SetProcess(MemoryReader::ProcessId processId) {
+    targetProcess.store(processId, std::memory_order_release);
+}
+
+void HpSampler::SetAddress(uintptr_t address) {
+    hpAddress.store(address, std::memory_order_release);
+}
+
+void HpSampler::SetBossAddress(uintptr_t address) {
+    bossHpAddress.store(address, std::memory_order_release);
+}
+
+std::chrono::steady_clock::time_point HpSampler::Step() {
+    auto now = std::chrono::steady_clock::now();
+
+    MemoryReader::ProcessId processId = targetProcess.load(std::memory_order_acquire);
+    if (processId != boundProcess) {
+        boundProcess = processId;
+        reader.Reset();
+        reader.SetTargetProcess(processId);
+        hasLastHP = false;
+    }
+
+    // Unbound slots sleep until the instance manager wakes them.
+    if (boundProcess == 0) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+
+    uintptr_t address = hpAddress.load(std::memory_order_acquire);
+    if (address == 0) {
+        hasLastHP = false;
+        return now + IDLE_INTERVAL;
+    }
+
+    if (!reader.IsInitialized() && !reader.Initialize(DS3StatsReader::PROCESS_NAME)) {
+        return now + IDLE_INTERVAL;
+    }
+
+    if (address != lastAddress) {
+        lastAddress = address;
+        hasLastHP = false;
+    }
+
+    // Player and boss HP go out in one batch, so a sample pairs values read at the same moment.
+    HpSample sample{};
+    sample.processId = boundProcess;
+    uintptr_t bossAddress = bossHpAddress.load(std::memory_order_acquire);
+    const MemoryRead reads[] = {
+        {address, &sample.hp, sizeof(sample.hp)},
+        {bossAddress, &sample.bossHP, sizeof(sample.bossHP) + sizeof(sample.bossMaxHP)}
+    };
+    static_assert(offsetof(HpSample, bossMaxHP) == offsetof(HpSample, bossHP) + sizeof(int32_t));
+
+    // A stale boss address must not cost the player's sample, so a failed pair is retried alone.
+    bool read = reader.ReadBatch(std::span<const MemoryRead>(reads, bossAddress != 0 ? 2 : 1));
+    if (!read && bossAddress != 0) {
+        sample.bossHP = 0;
+        sample.bossMaxHP = 0;
+        read = reader.ReadBatch(std::span<const MemoryRead>(reads, 1));
+    }
+
+    if (!read) {
+        if (!reader.IsProcessRunning()) {
+            reader.Reset();
+        }
+        return now + SAMPLE_INTERVAL;
+    }
+
+    bool changed = !hasLastHP || sample.hp != last.hp || sample.bossHP != last.bossHP || sample.bossMaxHP != last.bossMaxHP;
+    sample.sampledAt = std::chrono::system_clock::now();
+    if (changed && samples.TryPush(sample)) {
+        // A full ring keeps the change pending, so it is pushed again on the next tick.
+        last = sample;
+        hasLastHP = true;
+    }
+
+    return now + SAMPLE_INTERVAL;
+}
+
+bool HpSampler::Pop(HpSample& sample) {
+    while (samples.TryPop(sample)) {
+        if (sample.processId == targetProcess.load(std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../core/SpscRing.h"
+#include "../memory/MemoryReader.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+struct HpSample {
+    MemoryReader::ProcessId processId = 0;
+    std::chrono::system_clock::time_point sampledAt;
+    int32_t hp;
+    int32_t bossHP = 0;
+    int32_t bossMaxHP = 0;      // 0 when no boss is being followed
+};
+
+// Reads only the player's HP, and the boss's during a fight, at a much higher rate than
+// GameSampler, from the addresses its GameSampler resolved. Each change is pushed with its
+// timestamp for gameMonitorLoop, so a death is dated to the millisecond even when the player
+// respawns within one snapshot, and carries the boss HP at that moment.
+class HpSampler {
+private:
+    static constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds(10);
+    static constexpr auto IDLE_INTERVAL = std::chrono::milliseconds(100);
+    static constexpr size_t RING_CAPACITY = 1024;
+
+    std::atomic<MemoryReader::ProcessId> targetProcess{0};
+    std::atomic<uintptr_t> hpAddress{0};
+    std::atomic<uintptr_t> bossHpAddress{0};
+    SpscRing<HpSample, RING_CAPACITY> samples;
+
+    // Touched only by Step, which never runs on two threads at once.
+    MemoryReader reader;
+    MemoryReader::ProcessId boundProcess = 0;
+    uintptr_t lastAddress = 0;
+    HpSample last{};
+    bool hasLastHP = false;
+
+public:
+    // Called by the owning GameSampler; a process of 0 stops sampling until it is bound again.
+    void SetProcess(MemoryReader::ProcessId processId);
+
+    // Called by the owning GameSampler whenever it resolves the HP address; 0 pauses sampling.
+    void SetAddress(uintptr_t address);
+
+    // Address of the boss's HP followed by its max HP, from BossTracker; 0 outside a fight.
+    void SetBossAddress(uintptr_t address);
+
+    // One batched read; returns when the next one is due. Run by SamplerPool.
+    std::chrono::steady_clock::time_point Step();
+
+    // Consumer side, gameMonitorLoop only. Samples still queued from a process the sampler has
+    // since been rebound away from are dropped, so they cannot be read as the new game's.
+    bool Pop(HpSample& sample);
+};
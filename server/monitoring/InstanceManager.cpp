@@ -0,0 +1,83 @@
+#include "InstanceManager.h"
+#include "GameMonitor.h"
+#include "../core/Log.h"
+#include "../memory/DS3StatsReader.h"
+#include "../memory/WatchList.h"
+
+#include <algorithm>
+#include <string>
+
+InstanceManager g_instanceManager;
+
+void InstanceManager::Bind(size_t instance, MemoryReader::ProcessId processId) {
+    g_gameSamplers[instance].SetTargetProcess(processId);
+    pool.Wake(samplerJobs[instance]);
+    pool.Wake(hpJobs[instance]);
+}
+
+void InstanceManager::Release(MemoryReader::ProcessId processId) {
+    for (size_t instance = 0; instance < MAX_INSTANCES; ++instance) {
+        if (g_gameSamplers[instance].GetTargetProcess() == processId) {
+            log(LogLevel::INFO, "Game process " + std::to_string(processId) + " exited, releasing instance " + std::to_string(instance));
+            Bind(instance, 0);
+        }
+    }
+}
+
+void InstanceManager::Discover() {
+    for (MemoryReader::ProcessId processId : MemoryReader::FindProcesses(DS3StatsReader::PROCESS_NAME)) {
+        bool tracked = std::any_of(g_gameSamplers.begin(), g_gameSamplers.end(),
+            [&](const GameSampler& sampler) { return sampler.GetTargetProcess() == processId; });
+        if (tracked) {
+            continue;
+        }
+
+        auto freeSlot = std::find_if(g_gameSamplers.begin(), g_gameSamplers.end(),
+            [](const GameSampler& sampler) { return sampler.GetTargetProcess() == 0; });
+        if (freeSlot == g_gameSamplers.end()) {
+            if (!warnedFull) {
+                log(LogLevel::WARN, "More than " + std::to_string(MAX_INSTANCES) + " game instances, ignoring the rest");
+                warnedFull = true;
+            }
+            return;
+        }
+
+        // A process that cannot be waited on would never be released, so it is not tracked.
+        if (!watcher.Add(processId)) {
+            continue;
+        }
+
+        size_t instance = static_cast<size_t>(freeSlot - g_gameSamplers.begin());
+        log(LogLevel::INFO, "Tracking game process " + std::to_string(processId) + " as instance " + std::to_string(instance));
+        Bind(instance, processId);
+    }
+}
+
+void InstanceManager::Run() {
+    WatchList watchList;
+    watchList.Load();
+
+    for (size_t instance = 0; instance < MAX_INSTANCES; ++instance) {
+        GameSampler& sampler = g_gameSamplers[instance];
+        sampler.Start(watchList);
+        samplerJobs[instance] = pool.Add([&sampler] { return sampler.Step(); });
+        hpJobs[instance] = pool.Add([&sampler] { return sampler.GetHpSampler().Step(); });
+    }
+
+    pool.Start();
+
+    while (g_running) {
+        Discover();
+
+        for (MemoryReader::ProcessId processId : watcher.WaitForExits(DISCOVERY_INTERVAL)) {
+            Release(processId);
+            warnedFull = false;
+        }
+    }
+
+    pool.Stop();
+
+    for (GameSampler& sampler : g_gameSamplers) {
+        sampler.NotifyWaiters();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "GameSampler.h"
+#include "SamplerPool.h"
+#include "../memory/MemoryReader.h"
+#include "../memory/ProcessWatcher.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// Finds every running game process and binds each to a free GameSampler slot. All slots
+// share one SamplerPool, and one ProcessWatcher reports exits, so a closed game is released
+// and its slot sampled again immediately rather than on its next tick.
+class InstanceManager {
+private:
+    static constexpr auto DISCOVERY_INTERVAL = std::chrono::milliseconds(2000);
+
+    SamplerPool pool;
+    ProcessWatcher watcher;
+
+    std::array<size_t, MAX_INSTANCES> samplerJobs{};
+    std::array<size_t, MAX_INSTANCES> hpJobs{};
+    bool warnedFull = false;
+
+    void Discover();
+    void Bind(size_t instance, MemoryReader::ProcessId processId);
+    void Release(MemoryReader::ProcessId processId);
+
+public:
+    // Runs until g_running is cleared, then stops the pool and releases every waiter.
+    void Run();
+};
+
+extern InstanceManager g_instanceManager;
@@ -0,0 +1,98 @@
+#include "SamplerPool.h"
+
+#include <algorithm>
+
+SamplerPool::~SamplerPool() {
+    Stop();
+}
+
+size_t SamplerPool::Add(Step step) {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back({std::move(step)});
+
+    // The first step runs as soon as the pool starts.
+    wheel.Schedule(jobs.size() - 1, Clock::time_point{});
+    return jobs.size() - 1;
+}
+
+void SamplerPool::Start() {
+    size_t workerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_WORKERS);
+    workerCount = std::min(workerCount, std::max<size_t>(jobs.size(), 1));
+
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+void SamplerPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void SamplerPool::Wake(size_t job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (jobs[job].running) {
+            jobs[job].woken = true;
+        } else if (!jobs[job].queued) {
+            wheel.Schedule(job, Clock::time_point{});
+        }
+    }
+    cv.notify_all();
+}
+
+void SamplerPool::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopping) {
+        if (ready.empty()) {
+            wheel.Advance(Clock::now(), expired);
+            for (size_t id : expired) {
+                jobs[id].queued = true;
+                ready.push_back(id);
+            }
+
+            // Jobs due in the same tick go to every idle worker, not just this one.
+            if (expired.size() > 1) {
+                cv.notify_all();
+            }
+            expired.clear();
+        }
+
+        if (ready.empty()) {
+            auto wakeup = wheel.NextWakeup();
+            if (wakeup) {
+                cv.wait_until(lock, *wakeup);
+            } else {
+                cv.wait(lock);
+            }
+            continue;
+        }
+
+        size_t id = ready.front();
+        ready.pop_front();
+
+        Job& job = jobs[id];
+        job.queued = false;
+        job.running = true;
+        lock.unlock();
+
+        Clock::time_point due = job.step();
+
+        lock.lock();
+        job.running = false;
+        wheel.Schedule(id, job.woken ? Clock::time_point{} : due);
+        job.woken = false;
+
+        // Another worker may be asleep until a later deadline than the one just set.
+        cv.notify_one();
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../core/TimerWheel.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A few worker threads shared by every periodic sampling job, so tracking more game
+// instances adds jobs rather than threads. Each step returns when it
+// next wants to run, or Clock::time_point::max() to wait for Wake. Deadlines are kept in a
+// TimerWheel, so workers sleep until the next one and jobs due in the same tick are taken
+// together, earliest first. A job never runs on two workers at once, so one busy instance
+// cannot starve the others.
+class SamplerPool {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Step = std::function<Clock::time_point()>;
+
+private:
+    static constexpr size_t MAX_WORKERS = 4;
+
+    struct Job {
+        Step step;
+        bool queued = false;    // due and waiting in ready
+        bool running = false;
+        bool woken = false;
+    };
+
+    std::vector<Job> jobs;
+    TimerWheel wheel;
+    std::deque<size_t> ready;
+    std::vector<size_t> expired;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void WorkerLoop();
+
+public:
+    SamplerPool() = default;
+    ~SamplerPool();
+
+    SamplerPool(const SamplerPool&) = delete;
+    SamplerPool& operator=(const SamplerPool&) = delete;
+
+    // Jobs are added before Start and live until Stop; the returned id is passed to Wake.
+    size_t Add(Step step);
+
+    void Start();
+    void Stop();
+
+    // Runs the job as soon as a worker is free, or right after its current step.
+    void Wake(size_t job);
+};
@@ -0,0 +1,75 @@
+#include "SamplingPolicy.h"
+#include "../core/Settings.h"
+
+#include <array>
+
+namespace {
+    using std::chrono::milliseconds;
+
+    // Rows are SamplingMode, columns are FieldGroup. Vitals run at 40 Hz in combat so a death
+    // or a boss entry is seen within a frame or two; the menu and a closed game cost next to nothing.
+    // Event flags are one 256 KB block read, so they stay at a couple of Hz. Position in game
+    // follows the trajectory rate setting; its column only applies when that is off. The
+    // inventory is only diffed in game, at a rate that dates estus sips and pickups closely.
+    constexpr std::array<std::array<milliseconds, FIELD_GROUP_COUNT>, SAMPLING_MODE_COUNT> INTERVALS = {{
+        {milliseconds(2000), milliseconds(2000), milliseconds(2000), milliseconds(2000), milliseconds(2000), milliseconds(2000)},
+        {milliseconds(1000), milliseconds(1000), milliseconds(3000), milliseconds(3000), milliseconds(3000), milliseconds(3000)},
+        {milliseconds(100), milliseconds(250), milliseconds(2000), milliseconds(500), milliseconds(1000), milliseconds(500)},
+        {milliseconds(25), milliseconds(100), milliseconds(5000), milliseconds(500), milliseconds(1000), milliseconds(500)},
+    }};
+}
+
+namespace SamplingPolicy {
+    SamplingMode Classify(bool isProcessRunning, GameState gameState, std::optional<bool> inBossFight,
+        std::optional<int32_t> playerHP, int32_t peakHP) {
+        if (!isProcessRunning) {
+            return SamplingMode::NotRunning;
+        }
+
+        // Load screens, the title screen and character select, as the root probe sees them.
+        if (gameState != GameState::InGame || !playerHP) {
+            return SamplingMode::Menu;
+        }
+
+        bool lowHP = peakHP > 0 && *playerHP * 100 < peakHP * LOW_HP_PERCENT;
+        if (inBossFight.value_or(false) || lowHP) {
+            return SamplingMode::Combat;
+        }
+
+        return SamplingMode::Exploring;
+    }
+
+    std::chrono::milliseconds GetInterval(SamplingMode mode, FieldGroup group) {
+        bool inGame = mode == SamplingMode::Exploring || mode == SamplingMode::Combat;
+        if (group == FieldGroup::Position && inGame) {
+            int rateHz = g_settings.trajectorySampleRateHz.load(std::memory_order_relaxed);
+            if (rateHz > 0) {
+                return milliseconds(1000 / rateHz);
+            }
+        }
+
+        return INTERVALS[static_cast<size_t>(mode)][static_cast<size_t>(group)];
+    }
+
+    const char* ToString(SamplingMode mode) {
+        switch (mode) {
+            case SamplingMode::NotRunning: return "not_running";
+            case SamplingMode::Menu: return "menu";
+            case SamplingMode::Exploring: return "exploring";
+            case SamplingMode::Combat: return "combat";
+            default: return "unknown";
+        }
+    }
+
+    const char* ToString(FieldGroup group) {
+        switch (group) {
+            case FieldGroup::Vitals: return "vitals";
+            case FieldGroup::Progress: return "progress";
+            case FieldGroup::Character: return "character";
+            case FieldGroup::Flags: return "flags";
+            case FieldGroup::Position: return "position";
+            case FieldGroup::Inventory: return "inventory";
+            default: return "unknown";
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../memory/GameState.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+enum class SamplingMode : size_t {
+    NotRunning,
+    Menu,
+    Exploring,
+    Combat,
+    Count
+};
+
+// Fields sampled together at one rate.
+enum class FieldGroup : size_t {
+    Vitals,     // HP, boss fight flag
+    Progress,   // deaths, playtime, play region
+    Character,  // name, class, stats
+    Flags,      // event flag region (boss kills, bonfires)
+    Position,   // player coordinates, at the trajectory rate from Settings while in game
+    Inventory,  // souls, item slots and equipment, for the inventory ledger
+    Count
+};
+
+inline constexpr size_t SAMPLING_MODE_COUNT = static_cast<size_t>(SamplingMode::Count);
+inline constexpr size_t FIELD_GROUP_COUNT = static_cast<size_t>(FieldGroup::Count);
+
+namespace SamplingPolicy {
+    // HP under this share of the highest HP seen for the character counts as danger.
+    inline constexpr int32_t LOW_HP_PERCENT = 30;
+
+    SamplingMode Classify(bool isProcessRunning, GameState gameState, std::optional<bool> inBossFight,
+        std::optional<int32_t> playerHP, int32_t peakHP);
+
+    std::chrono::milliseconds GetInterval(SamplingMode mode, FieldGroup group);
+
+    const char* ToString(SamplingMode mode);
+    const char* ToString(FieldGroup group);
+}
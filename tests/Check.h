@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Minimal assertions for the test programs: a failed CHECK prints where and carries on, and
+// TestResult turns the failure count into the exit code.
+inline int g_checkFailures = 0;
+
+#define CHECK(condition)                                                                \
+    do {                                                                                \
+        if (!(condition)) {                                                             \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++g_checkFailures;                                                          \
+        }                                                                               \
+    } while (0)
+
+inline int TestResult(const char* name) {
+    std::printf("%s: %s (%d failed)\n", name, g_checkFailures == 0 ? "ok" : "FAILED", g_checkFailures);
+    return g_checkFailures == 0 ? 0 : 1;
+}
+
+// Polls until the condition holds or the timeout passes; returns whether it held.
+template<typename Condition>
+bool WaitUntil(Condition condition, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
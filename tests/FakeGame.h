@@ -0,0 +1,64 @@
+#pragma once
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs tools/FakeTarget, built next to the test programs, as a child process that replays a
+// script (see FakeTarget.cpp for the format) in a loop until it is killed.
+class FakeGame {
+private:
+    pid_t processId = -1;
+    std::string scriptPath;
+
+public:
+    explicit FakeGame(std::string_view script) {
+        char path[] = "/tmp/ember-test-XXXXXX";
+        int fd = mkstemp(path);
+        if (fd < 0) {
+            return;
+        }
+        scriptPath = path;
+        bool written = write(fd, script.data(), script.size()) == static_cast<ssize_t>(script.size());
+        close(fd);
+        if (!written) {
+            return;
+        }
+
+        processId = fork();
+        if (processId == 0) {
+            execl("./FakeTarget", "./FakeTarget", "--script", path, "--loop", "--quiet", nullptr);
+            std::perror("execl ./FakeTarget");
+            _exit(127);
+        }
+    }
+
+    ~FakeGame() {
+        Kill();
+        if (!scriptPath.empty()) {
+            unlink(scriptPath.c_str());
+        }
+    }
+
+    FakeGame(const FakeGame&) = delete;
+    FakeGame& operator=(const FakeGame&) = delete;
+
+    // -1 if the script could not be written or the process not started.
+    pid_t GetProcessId() const {
+        return processId;
+    }
+
+    // Stops the game the way closing it would, and reaps it.
+    void Kill() {
+        if (processId <= 0) {
+            return;
+        }
+        kill(processId, SIGTERM);
+        waitpid(processId, nullptr, 0);
+        processId = -1;
+    }
+};
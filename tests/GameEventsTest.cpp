@@ -0,0 +1,165 @@
+// GameEventBus: transitions in order, StatsChanged coalesced to the latest, a subscriber
+// that falls TRANSITION_CAPACITY behind resynced instead, the slot limit, and one publisher
+// against several subscribers on their own threads.
+
+#include "Check.h"
+
+#include "monitoring/GameEvents.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+std::atomic<bool> g_running = true;
+
+namespace {
+    GameEvent MakeEvent(GameEventType type, uint32_t deaths, uint8_t instance = 0) {
+        GameEvent event;
+        event.type = type;
+        event.instance = instance;
+        event.deaths = deaths;
+        return event;
+    }
+
+    void TestOrderAndCoalescing() {
+        GameEventBus bus;
+        auto subscription = bus.Subscribe(0);
+        auto otherInstance = bus.Subscribe(1);
+        CHECK(subscription.IsValid());
+
+        bus.Publish(MakeEvent(GameEventType::GameDetected, 0));
+        for (uint32_t deaths = 1; deaths <= 100; ++deaths) {
+            bus.Publish(MakeEvent(GameEventType::StatsChanged, deaths));
+            bus.Publish(MakeEvent(GameEventType::StatsChanged, deaths));
+            bus.Publish(MakeEvent(GameEventType::Death, deaths));
+        }
+        bus.Publish(MakeEvent(GameEventType::StatsChanged, 100));
+
+        GameEvent event;
+        CHECK(subscription.Next(event, 0ms) && event.type == GameEventType::GameDetected);
+        uint64_t lastSequence = event.sequence;
+        for (uint32_t deaths = 1; deaths <= 100; ++deaths) {
+            CHECK(subscription.Next(event, 0ms) && event.type == GameEventType::Death && event.deaths == deaths);
+            CHECK(event.sequence > lastSequence);
+            lastSequence = event.sequence;
+        }
+
+        // Only the StatsChanged published after the last transition is left.
+        CHECK(subscription.Next(event, 0ms) && event.type == GameEventType::StatsChanged && event.deaths == 100);
+        CHECK(!subscription.Next(event, 0ms));
+        CHECK(!otherInstance.Next(event, 0ms));
+
+        // A new subscriber starts from the status the events left.
+        auto late = bus.Subscribe(0);
+        CHECK(late.Initial().isRunning && late.Initial().deaths == 100);
+        CHECK(!late.Next(event, 0ms));
+    }
+
+    void TestResync() {
+        GameEventBus bus;
+        auto subscription = bus.Subscribe(0);
+
+        bus.Publish(MakeEvent(GameEventType::GameDetected, 0));
+        for (uint32_t deaths = 1; deaths <= GameEventBus::TRANSITION_CAPACITY + 10; ++deaths) {
+            bus.Publish(MakeEvent(GameEventType::Death, deaths));
+        }
+        bus.Publish(MakeEvent(GameEventType::BossFightEntered, GameEventBus::TRANSITION_CAPACITY + 10));
+
+        GameEvent event;
+        CHECK(subscription.Next(event, 0ms) && event.type == GameEventType::Resync);
+        CHECK(subscription.Initial().isRunning);
+        CHECK(subscription.Initial().inBossFight);
+        CHECK(subscription.Initial().deaths == GameEventBus::TRANSITION_CAPACITY + 10);
+        CHECK(!subscription.Next(event, 0ms));
+
+        // Queueing starts again after the resync.
+        bus.Publish(MakeEvent(GameEventType::GameExited, 0));
+        CHECK(subscription.Next(event, 0ms) && event.type == GameEventType::GameExited);
+    }
+
+    void TestSlotLimit() {
+        GameEventBus bus;
+        std::vector<GameEventBus::Subscription> subscriptions;
+        for (size_t i = 0; i < GameEventBus::MAX_SUBSCRIBERS; ++i) {
+            subscriptions.push_back(bus.Subscribe(0));
+            CHECK(subscriptions.back().IsValid());
+        }
+        CHECK(!bus.Subscribe(0).IsValid());
+
+        subscriptions.pop_back();
+        CHECK(bus.Subscribe(0).IsValid());
+        CHECK(!bus.Subscribe(GameEventBus::INSTANCE_COUNT).IsValid());
+    }
+
+    // Every subscriber ends on the last published status, whether it kept up or was resynced,
+    // and never sees sequences go backwards.
+    void TestThreads() {
+        constexpr uint32_t EVENTS = 100'000;
+        GameEventBus bus;
+        std::atomic<int> errors = 0;
+        std::atomic<int> ready = 0;
+        std::atomic<bool> done = false;
+        std::vector<uint32_t> finalDeaths(4);
+
+        std::vector<std::thread> subscribers;
+        for (size_t t = 0; t < finalDeaths.size(); ++t) {
+            subscribers.emplace_back([&, t] {
+                auto subscription = bus.Subscribe(0);
+                GameStatus status = subscription.Initial();
+                ++ready;
+
+                uint64_t lastSequence = 0;
+                GameEvent event;
+                for (int taken = 0;; ++taken) {
+                    if (!subscription.Next(event, 50ms)) {
+                        if (done) {
+                            break;
+                        }
+                        continue;
+                    }
+                    if (event.sequence <= lastSequence) {
+                        ++errors;
+                    }
+                    lastSequence = event.sequence;
+
+                    ApplyGameEvent(status, event);
+                    if (event.type == GameEventType::Resync) {
+                        status = subscription.Initial();
+                    }
+                    // The first subscriber drains slowly enough to be resynced.
+                    if (t == 0 && taken % 100 == 0) {
+                        std::this_thread::sleep_for(5ms);
+                    }
+                }
+                finalDeaths[t] = status.deaths;
+            });
+        }
+
+        while (ready < static_cast<int>(finalDeaths.size())) {
+            std::this_thread::yield();
+        }
+        for (uint32_t i = 1; i <= EVENTS; ++i) {
+            bus.Publish(MakeEvent(i % 5 == 0 ? GameEventType::Death : GameEventType::StatsChanged, i));
+        }
+        std::this_thread::sleep_for(200ms);
+        done = true;
+        for (std::thread& subscriber : subscribers) {
+            subscriber.join();
+        }
+
+        CHECK(errors == 0);
+        for (uint32_t deaths : finalDeaths) {
+            CHECK(deaths == EVENTS);
+        }
+    }
+}
+
+int main() {
+    TestOrderAndCoalescing();
+    TestResync();
+    TestSlotLimit();
+    TestThreads();
+    return TestResult("GameEventsTest");
+}
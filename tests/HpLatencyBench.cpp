@@ -0,0 +1,105 @@
+// Death detection latency: how long after the game's HP changes HpSampler has a sample of
+// it. HpSampler follows a word in FakeTarget's module image that FakeTarget never touches;
+// the benchmark flips it between 0 and full HP with process_vm_writev at random intervals,
+// noting the time of each write, and reads the timestamps of the samples that show it.
+
+#include "Check.h"
+#include "FakeGame.h"
+
+#include "memory/DS3StatsReader.h"
+#include "memory/MemoryReader.h"
+#include "monitoring/HpSampler.h"
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    constexpr int TOGGLES = 100;
+    constexpr int32_t FULL_HP = 500;
+
+    bool WriteHP(pid_t processId, uintptr_t address, int32_t hp) {
+        iovec local{&hp, sizeof(hp)};
+        iovec remote{reinterpret_cast<void*>(address), sizeof(hp)};
+        return process_vm_writev(processId, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(sizeof(hp));
+    }
+
+    double Percentile(std::vector<double> values, double fraction) {
+        std::sort(values.begin(), values.end());
+        return values[static_cast<size_t>(fraction * static_cast<double>(values.size() - 1))];
+    }
+}
+
+int main() {
+    FakeGame game("0 set name Bench\n60000 add souls 1\n");
+    pid_t processId = game.GetProcessId();
+
+    MemoryReader reader;
+    reader.SetTargetProcess(processId);
+    CHECK(WaitUntil([&] { return reader.Initialize(DS3StatsReader::PROCESS_NAME).has_value(); }, 5s));
+    uintptr_t hpAddress = reader.GetModuleBase() + reader.GetModuleSize() - 0x1000;
+    CHECK(WriteHP(processId, hpAddress, FULL_HP));
+
+    // Run the way SamplerPool runs it: Step, then sleep until the time it asks for.
+    HpSampler sampler;
+    sampler.SetProcess(processId);
+    sampler.SetAddress(hpAddress);
+    std::atomic<bool> stop = false;
+    std::thread samplerThread([&] {
+        while (!stop) {
+            std::this_thread::sleep_until(std::min(sampler.Step(), std::chrono::steady_clock::now() + 100ms));
+        }
+    });
+
+    HpSample sample;
+    CHECK(WaitUntil([&] { return sampler.Pop(sample) && sample.hp == FULL_HP; }, 2s));
+
+    std::mt19937 rng(1);
+    std::vector<double> latencies;
+    for (int i = 0; i < TOGGLES; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30 + rng() % 120));
+
+        int32_t hp = i % 2 == 0 ? 0 : FULL_HP;
+        auto writtenAt = std::chrono::system_clock::now();
+        if (!WriteHP(processId, hpAddress, hp)) {
+            break;
+        }
+
+        bool seen = WaitUntil([&] {
+            while (sampler.Pop(sample)) {
+                if (sample.hp == hp) {
+                    return true;
+                }
+            }
+            return false;
+        }, 1s);
+        if (seen) {
+            latencies.push_back(std::chrono::duration<double, std::milli>(sample.sampledAt - writtenAt).count());
+        }
+    }
+
+    stop = true;
+    samplerThread.join();
+
+    CHECK(latencies.size() == TOGGLES);
+    if (!latencies.empty()) {
+        double mean = 0;
+        for (double latency : latencies) {
+            mean += latency;
+        }
+        mean /= static_cast<double>(latencies.size());
+
+        std::printf("HP changes seen: %zu of %d\n", latencies.size(), TOGGLES);
+        std::printf("latency: mean %.2f ms, median %.2f ms, p99 %.2f ms, max %.2f ms\n", mean,
+            Percentile(latencies, 0.5), Percentile(latencies, 0.99), Percentile(latencies, 1.0));
+        CHECK(Percentile(latencies, 1.0) < 50);
+    }
+    return TestResult("HpLatencyBench");
+}
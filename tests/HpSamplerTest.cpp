@@ -0,0 +1,60 @@
+// HpSampler rebound from one FakeTarget to another: samples still queued from the first
+// process are dropped rather than handed over as the second one's.
+
+#include "Check.h"
+#include "FakeGame.h"
+
+#include "memory/DS3StatsReader.h"
+#include "memory/MemoryReader.h"
+#include "monitoring/HpSampler.h"
+
+#include <sys/uio.h>
+
+#include <cstdint>
+
+using namespace std::chrono_literals;
+
+namespace {
+    // A word in the module image FakeTarget never touches, as in HpLatencyBench.
+    uintptr_t PrepareHP(pid_t processId, int32_t hp) {
+        MemoryReader reader;
+        reader.SetTargetProcess(processId);
+        if (!WaitUntil([&] { return reader.Initialize(DS3StatsReader::PROCESS_NAME).has_value(); }, 5s)) {
+            return 0;
+        }
+
+        uintptr_t address = reader.GetModuleBase() + reader.GetModuleSize() - 0x1000;
+        iovec local{&hp, sizeof(hp)};
+        iovec remote{reinterpret_cast<void*>(address), sizeof(hp)};
+        return process_vm_writev(processId, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(sizeof(hp)) ? address : 0;
+    }
+
+    void TestRebind() {
+        FakeGame first("0 set name First\n60000 add souls 1\n");
+        FakeGame second("0 set name Second\n60000 add souls 1\n");
+        uintptr_t firstAddress = PrepareHP(first.GetProcessId(), 100);
+        uintptr_t secondAddress = PrepareHP(second.GetProcessId(), 200);
+        CHECK(firstAddress != 0 && secondAddress != 0);
+
+        HpSampler sampler;
+        sampler.SetProcess(first.GetProcessId());
+        sampler.SetAddress(firstAddress);
+        sampler.Step();
+
+        // The first process's sample is left queued across the rebind.
+        sampler.SetProcess(second.GetProcessId());
+        sampler.SetAddress(secondAddress);
+        HpSample sample;
+        CHECK(!sampler.Pop(sample));
+
+        sampler.Step();
+        CHECK(sampler.Pop(sample));
+        CHECK(sample.processId == second.GetProcessId() && sample.hp == 200);
+        CHECK(!sampler.Pop(sample));
+    }
+}
+
+int main() {
+    TestRebind();
+    return TestResult("HpSamplerTest");
+}
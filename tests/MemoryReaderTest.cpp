@@ -0,0 +1,137 @@
+// MemoryReader's Linux backend against FakeTarget: attaching by name and pid, single and
+// batched process_vm_readv reads, failure on unmapped addresses, and DS3StatsReader
+// reporting NotLoaded through a load screen.
+
+#include "Check.h"
+#include "FakeGame.h"
+
+#include "memory/DS3Fields.h"
+#include "memory/DS3StatsReader.h"
+#include "memory/GameBuilds.h"
+#include "memory/MemoryReader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+using namespace std::chrono_literals;
+
+namespace {
+    constexpr const char* SCRIPT =
+        "0 set name Tester\n"
+        "0 set deaths 7\n"
+        "0 set level 42\n"
+        "60000 add souls 1\n";
+
+    bool Attach(MemoryReader& reader, pid_t processId) {
+        reader.SetTargetProcess(processId);
+        return WaitUntil([&] { return reader.Initialize(DS3StatsReader::PROCESS_NAME).has_value(); }, 5s);
+    }
+
+    void TestRawReads(pid_t processId) {
+        MemoryReader reader;
+        CHECK(Attach(reader, processId));
+        CHECK(reader.GetProcessId() == processId);
+        CHECK(reader.GetModuleBase() != 0);
+        CHECK(reader.IsProcessRunning());
+
+        auto running = MemoryReader::FindProcesses(DS3StatsReader::PROCESS_NAME);
+        CHECK(std::find(running.begin(), running.end(), processId) != running.end());
+
+        // The module is mapped before FakeTarget lays out the heap behind it.
+        uintptr_t gameDataMan = 0;
+        CHECK(WaitUntil([&] {
+            return reader.ReadMemory(reader.GetModuleBase() + GameBuilds::FALLBACK.gameDataMan, gameDataMan)
+                && gameDataMan != 0;
+        }, 2s));
+
+        uint32_t deaths = 0;
+        CHECK(WaitUntil([&] {
+            return reader.ReadMemory(gameDataMan + DS3Fields::DeathCount::offset, deaths) && deaths == 7;
+        }, 2s));
+
+        // Three reads far apart in one call: the module header, deaths and playtime.
+        char header[2] = {};
+        uint32_t batchDeaths = 0;
+        uint32_t playTime = 0;
+        MemoryRead reads[] = {
+            {reader.GetModuleBase(), header, sizeof(header)},
+            {gameDataMan + DS3Fields::DeathCount::offset, &batchDeaths, sizeof(batchDeaths)},
+            {gameDataMan + DS3Fields::PlayTime::offset, &playTime, sizeof(playTime)},
+        };
+        CHECK(reader.ReadBatch(reads));
+        CHECK(std::memcmp(header, "MZ", 2) == 0);
+        CHECK(batchDeaths == 7);
+        CHECK(playTime != 0);
+
+        // Any unreadable entry fails the whole batch.
+        uint32_t unmapped = 0;
+        MemoryRead badReads[] = {
+            {gameDataMan + DS3Fields::DeathCount::offset, &batchDeaths, sizeof(batchDeaths)},
+            {0x10, &unmapped, sizeof(unmapped)},
+        };
+        CHECK(!reader.ReadBatch(badReads));
+        CHECK(!reader.ReadMemory(uintptr_t{0}, unmapped));
+    }
+
+    void TestStatsReader(pid_t processId) {
+        DS3StatsReader stats;
+        stats.GetSource().SetTargetProcess(processId);
+        CHECK(WaitUntil([&] { return stats.Initialize().has_value(); }, 5s));
+        CHECK(WaitUntil([&] { return stats.GetGameState() == GameState::InGame; }, 2s));
+
+        auto deaths = stats.GetDeathCount();
+        CHECK(deaths && *deaths == 7);
+        auto name = stats.GetCharacterName();
+        CHECK(name && *name == L"Tester");
+        auto characterStats = stats.GetCharacterStats();
+        CHECK(characterStats && characterStats->level == 42);
+    }
+
+    // FakeTarget nulls WorldChrMan while loading: fields behind it are NotLoaded, those behind
+    // GameDataMan still read, and everything comes back once the load ends.
+    void TestLoading() {
+        FakeGame game(
+            "0 set name Tester\n"
+            "0 set hp 500\n"
+            "0 set loading 1\n"
+            "1500 set loading 0\n"
+            "60000 add souls 1\n");
+        DS3StatsReader stats;
+        stats.GetSource().SetTargetProcess(game.GetProcessId());
+        CHECK(WaitUntil([&] { return stats.Initialize().has_value(); }, 5s));
+
+        // GameDataMan is null too until FakeTarget has laid out its heap.
+        CHECK(WaitUntil([&] {
+            auto name = stats.GetCharacterName();
+            return name && *name == L"Tester";
+        }, 2s));
+        CHECK(stats.GetGameState() == GameState::Loading);
+
+        auto hp = stats.GetPlayerHP();
+        CHECK(!hp && hp.error() == MemoryReaderError::NotLoaded);
+        auto position = stats.GetPlayerPosition();
+        CHECK(!position && position.error() == MemoryReaderError::NotLoaded);
+        auto root = stats.GetRootAddress(PathRoot::WorldChrMan);
+        CHECK(!root && root.error() == MemoryReaderError::NotLoaded);
+
+        // Within PLAN_TTL the block is not read again, and keeps its error.
+        hp = stats.GetPlayerHP();
+        CHECK(!hp && hp.error() == MemoryReaderError::NotLoaded);
+
+        CHECK(WaitUntil([&] { return stats.GetGameState() == GameState::InGame; }, 3s));
+        hp = stats.GetPlayerHP();
+        CHECK(hp && *hp == 500);
+    }
+}
+
+int main() {
+    {
+        FakeGame game(SCRIPT);
+        CHECK(game.GetProcessId() > 0);
+        TestRawReads(game.GetProcessId());
+        TestStatsReader(game.GetProcessId());
+    }
+    TestLoading();
+    return TestResult("MemoryReaderTest");
+}
@@ -0,0 +1,118 @@
+// ProcessWatcher against real child processes: a kill wakes WaitForExits long before its
+// timeout, several exits are all reported, removed and dead processes are not watched.
+
+#include "Check.h"
+
+#include "memory/ProcessWatcher.h"
+
+#include <algorithm>
+#include <csignal>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    pid_t SpawnSleeper() {
+        pid_t processId = fork();
+        if (processId == 0) {
+            for (;;) {
+                pause();
+            }
+        }
+        return processId;
+    }
+
+    void KillAndReap(pid_t processId) {
+        kill(processId, SIGKILL);
+        waitpid(processId, nullptr, 0);
+    }
+
+    bool Contains(const std::vector<pid_t>& processIds, pid_t processId) {
+        return std::find(processIds.begin(), processIds.end(), processId) != processIds.end();
+    }
+
+    void TestWakesOnExit() {
+        ProcessWatcher watcher;
+        pid_t first = SpawnSleeper();
+        pid_t second = SpawnSleeper();
+        CHECK(watcher.Add(first));
+        CHECK(watcher.Add(second));
+        CHECK(watcher.Add(first));
+
+        auto start = std::chrono::steady_clock::now();
+        CHECK(watcher.WaitForExits(50ms).empty());
+        CHECK(std::chrono::steady_clock::now() - start >= 45ms);
+
+        std::thread killer([&] {
+            std::this_thread::sleep_for(100ms);
+            kill(second, SIGKILL);
+        });
+        start = std::chrono::steady_clock::now();
+        auto exited = watcher.WaitForExits(5s);
+        auto waited = std::chrono::steady_clock::now() - start;
+        killer.join();
+
+        CHECK(exited == std::vector<pid_t>{second});
+        CHECK(waited < 1s);
+        std::printf("WaitForExits returned %.1f ms after the wait began (kill at 100 ms)\n",
+            std::chrono::duration<double, std::milli>(waited).count());
+        waitpid(second, nullptr, 0);
+
+        // The exited process is no longer watched; the other still is.
+        CHECK(watcher.WaitForExits(20ms).empty());
+        KillAndReap(first);
+        CHECK(watcher.WaitForExits(1s) == std::vector<pid_t>{first});
+    }
+
+    void TestSeveralExits() {
+        ProcessWatcher watcher;
+        std::vector<pid_t> children;
+        for (int i = 0; i < 4; ++i) {
+            children.push_back(SpawnSleeper());
+            CHECK(watcher.Add(children.back()));
+        }
+
+        KillAndReap(children[0]);
+        KillAndReap(children[2]);
+
+        std::vector<pid_t> exited;
+        WaitUntil([&] {
+            for (pid_t processId : watcher.WaitForExits(50ms)) {
+                exited.push_back(processId);
+            }
+            return exited.size() >= 2;
+        }, 1s);
+        CHECK(exited.size() == 2);
+        CHECK(Contains(exited, children[0]));
+        CHECK(Contains(exited, children[2]));
+
+        KillAndReap(children[1]);
+        KillAndReap(children[3]);
+    }
+
+    void TestRemoveAndDead() {
+        ProcessWatcher watcher;
+        pid_t child = SpawnSleeper();
+        CHECK(watcher.Add(child));
+        watcher.Remove(child);
+        KillAndReap(child);
+        CHECK(watcher.WaitForExits(50ms).empty());
+
+        // Already reaped: nothing to wait on.
+        CHECK(!watcher.Add(child));
+
+        auto start = std::chrono::steady_clock::now();
+        CHECK(watcher.WaitForExits(20ms).empty());
+        CHECK(std::chrono::steady_clock::now() - start >= 15ms);
+    }
+}
+
+int main() {
+    TestWakesOnExit();
+    TestSeveralExits();
+    TestRemoveAndDead();
+    return TestResult("ProcessWatcherTest");
+}
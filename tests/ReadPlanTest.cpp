@@ -0,0 +1,101 @@
+// ReadPlan coalescing: which fields share a block, where each lands in the buffer, and
+// decoding; then the plan DS3StatsReader compiles for DS3Fields::All.
+
+#include "Check.h"
+
+#include "memory/DS3Fields.h"
+#include "memory/ReadPlan.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    void TestMerging() {
+        ReadPlan plan;
+        size_t first = plan.AddField(0, 0x10, 4);
+        size_t withinGap = plan.AddField(0, 0x14 + ReadPlan::MAX_GAP, 4);
+        size_t pastGap = plan.AddField(0, 0x1000, 8);
+        size_t otherChain = plan.AddField(1, 0x10, 4);
+        size_t overlapping = plan.AddField(0, 0x12, 4);
+        plan.Compile();
+
+        auto blocks = plan.GetBlocks();
+        CHECK(blocks.size() == 3);
+        CHECK(plan.GetFieldBlock(first) == plan.GetFieldBlock(withinGap));
+        CHECK(plan.GetFieldBlock(first) == plan.GetFieldBlock(overlapping));
+        CHECK(plan.GetFieldBlock(first) != plan.GetFieldBlock(pastGap));
+        CHECK(plan.GetFieldBlock(first) != plan.GetFieldBlock(otherChain));
+
+        const PlannedBlock& merged = blocks[plan.GetFieldBlock(first)];
+        CHECK(merged.chain == 0);
+        CHECK(merged.offset == 0x10);
+        CHECK(merged.size == 0x8 + ReadPlan::MAX_GAP);
+        CHECK(blocks[plan.GetFieldBlock(otherChain)].chain == 1);
+
+        // Blocks sit back to back in the buffer.
+        size_t expectedOffset = 0;
+        for (const PlannedBlock& block : blocks) {
+            CHECK(block.bufferOffset == expectedOffset);
+            expectedOffset += block.size;
+        }
+    }
+
+    void TestDecode() {
+        ReadPlan plan;
+        size_t low = plan.AddField(0, 0x40, 4);
+        size_t high = plan.AddField(0, 0x48, 2);
+        plan.Compile();
+
+        uint32_t lowValue = 0;
+        CHECK(!plan.Decode(low, lowValue));
+
+        size_t block = plan.GetFieldBlock(low);
+        uint8_t* data = plan.GetBlockData(block);
+        uint32_t written = 0xDEADBEEF;
+        uint16_t writtenHigh = 0x1234;
+        std::memcpy(data, &written, sizeof(written));
+        std::memcpy(data + 8, &writtenHigh, sizeof(writtenHigh));
+        plan.SetBlockValid(block, true);
+
+        CHECK(plan.Decode(low, lowValue) && lowValue == written);
+        uint16_t highValue = 0;
+        CHECK(plan.Decode(high, highValue) && highValue == writtenHigh);
+        uint32_t wrongSize = 0;
+        CHECK(!plan.Decode(high, wrongSize));
+
+        plan.InvalidateAll();
+        CHECK(!plan.Decode(low, lowValue));
+    }
+
+    // DS3StatsReader's plan: every field lands inside its block, and the number of blocks
+    // is the number of reads a full refresh costs.
+    void TestStatsReaderPlan() {
+        using Fields = DS3Fields::All;
+
+        ReadPlan plan;
+        for (const FieldSpec& spec : Fields::specs) {
+            plan.AddField(spec.chain, spec.offset, spec.size);
+        }
+        plan.Compile();
+
+        auto blocks = plan.GetBlocks();
+        for (size_t i = 0; i < Fields::count; ++i) {
+            const FieldSpec& spec = Fields::specs[i];
+            const PlannedBlock& block = blocks[plan.GetFieldBlock(i)];
+            CHECK(block.chain == spec.chain);
+            CHECK(block.offset <= spec.offset && spec.offset + spec.size <= block.offset + block.size);
+        }
+
+        // GameDataMan, the player (two ranges), the HP struct, the physics block, WorldChrMan's
+        // character list, and the character data with the equip slots apart from the rest.
+        CHECK(blocks.size() == 8);
+        std::printf("DS3Fields::All: %zu fields in %zu blocks\n", Fields::count, blocks.size());
+    }
+}
+
+int main() {
+    TestMerging();
+    TestDecode();
+    TestStatsReaderPlan();
+    return TestResult("ReadPlanTest");
+}
@@ -0,0 +1,82 @@
+// Reads per monitor tick against FakeTarget. Every process_vm_readv the program makes is
+// counted by wrapping the libc call, and compared with walking every field's pointer chain
+// from the module base, which is what each getter did before chains were cached.
+
+#include "Check.h"
+#include "FakeGame.h"
+
+#include "memory/DS3Fields.h"
+#include "memory/DS3StatsReader.h"
+
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+using namespace std::chrono_literals;
+
+namespace {
+    uint64_t g_kernelReads = 0;
+
+    // What one monitor tick reads: deaths, playtime, region, boss fight and HP, then the
+    // character's name, class, level and stats.
+    using TickFields = TypeList<
+        DS3Fields::DeathCount, DS3Fields::PlayTime, DS3Fields::PlayRegion, DS3Fields::BossFight,
+        DS3Fields::PlayerHP, DS3Fields::CharacterName, DS3Fields::CharacterClass, DS3Fields::Level,
+        DS3Fields::Vigor, DS3Fields::Attunement, DS3Fields::Endurance, DS3Fields::Vitality,
+        DS3Fields::Strength, DS3Fields::Dexterity, DS3Fields::Intelligence, DS3Fields::Faith,
+        DS3Fields::Luck>;
+
+    // Reading a field from scratch: the root pointer, one dereference per offset, the value.
+    template<typename... TickField>
+    constexpr size_t UncachedReads(TypeList<TickField...>) {
+        return ((2 + TickField::Chain::depth) + ...);
+    }
+
+    void Tick(DS3StatsReader& stats) {
+        bool ok = stats.GetDeathCount() && stats.GetPlayTime() && stats.GetPlayRegion()
+            && stats.GetInBossFight() && stats.GetPlayerHP() && stats.GetCharacterName()
+            && stats.GetClass() && stats.GetCharacterStats();
+        CHECK(ok);
+    }
+}
+
+extern "C" ssize_t process_vm_readv(pid_t pid, const iovec* localIov, unsigned long localCount,
+    const iovec* remoteIov, unsigned long remoteCount, unsigned long flags) noexcept {
+    ++g_kernelReads;
+    return syscall(SYS_process_vm_readv, pid, localIov, localCount, remoteIov, remoteCount, flags);
+}
+
+int main() {
+    constexpr int TICKS = 200;
+    constexpr auto TICK_INTERVAL = 20ms;     // past PLAN_TTL, so every tick reads afresh
+
+    FakeGame game("0 set name Bench\n0 set deaths 3\n60000 add souls 1\n");
+    DS3StatsReader stats;
+    stats.GetSource().SetTargetProcess(game.GetProcessId());
+    CHECK(WaitUntil([&] { return stats.Initialize().has_value(); }, 5s));
+    CHECK(WaitUntil([&] { return stats.GetGameState() == GameState::InGame; }, 2s));
+
+    uint64_t before = g_kernelReads;
+    Tick(stats);
+    uint64_t firstTick = g_kernelReads - before;
+
+    before = g_kernelReads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TICKS; ++i) {
+        std::this_thread::sleep_for(TICK_INTERVAL);
+        Tick(stats);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double perTick = static_cast<double>(g_kernelReads - before) / TICKS;
+
+    constexpr size_t uncached = UncachedReads(TickFields{});
+    std::printf("uncached chain walks: %zu reads per tick (%zu fields)\n", uncached, TickFields::size);
+    std::printf("first tick:           %llu reads (chains resolved)\n", static_cast<unsigned long long>(firstTick));
+    std::printf("steady state:         %.2f reads per tick over %d ticks in %.1f s (root probe included)\n",
+        perTick, TICKS, seconds);
+
+    CHECK(perTick < uncached);
+    return TestResult("ReadsPerTickBench");
+}
@@ -0,0 +1,141 @@
+// SignatureScanner against a naive masked search on random buffers and patterns, including
+// matches at either end of the image, plus pattern parsing, RIP-relative resolution and
+// reading the PE timestamp from a module header.
+
+#include "Check.h"
+
+#include "memory/SignatureScanner.h"
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+    std::optional<size_t> NaiveFind(const std::vector<uint8_t>& image, const Signature& signature) {
+        for (size_t i = 0; i + signature.bytes.size() <= image.size(); ++i) {
+            bool matches = true;
+            for (size_t j = 0; j < signature.bytes.size() && matches; ++j) {
+                matches = signature.wildcard[j] || image[i + j] == signature.bytes[j];
+            }
+            if (matches) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void TestParse() {
+        auto signature = Signature::Parse("48 8B 05 ?? ? c3");
+        CHECK(signature.has_value());
+        if (signature) {
+            CHECK((signature->bytes == std::vector<uint8_t>{0x48, 0x8B, 0x05, 0, 0, 0xC3}));
+            CHECK((signature->wildcard == std::vector<bool>{false, false, false, true, true, false}));
+        }
+
+        CHECK(!Signature::Parse("?? ??"));
+        CHECK(!Signature::Parse(""));
+        CHECK(!Signature::Parse("48 8G"));
+        CHECK(!Signature::Parse("48 8"));
+    }
+
+    // A four-letter alphabet makes partial matches, and so anchor hits that fail the full
+    // compare, common.
+    void TestAgainstNaive() {
+        std::mt19937 rng(1);
+        const uint8_t alphabet[] = {0x48, 0x8B, 0x05, 0xC3};
+        int mismatches = 0;
+
+        for (int round = 0; round < 20000; ++round) {
+            size_t imageSize = round % 10 == 0 ? 4096 + rng() % 64 : rng() % 200;
+            std::vector<uint8_t> image(imageSize);
+            for (uint8_t& byte : image) {
+                byte = alphabet[rng() % 4];
+            }
+
+            size_t length = 1 + rng() % 24;
+            Signature signature;
+            for (size_t i = 0; i < length; ++i) {
+                signature.bytes.push_back(alphabet[rng() % 4]);
+                signature.wildcard.push_back(rng() % 3 == 0);
+            }
+            signature.wildcard[rng() % length] = false;
+
+            // Half the patterns are copied from the image, often from either end.
+            if (rng() % 2 == 0 && image.size() >= length) {
+                size_t choice = rng() % 4;
+                size_t at = choice == 0 ? 0 : choice == 1 ? image.size() - length : rng() % (image.size() - length + 1);
+                std::memcpy(signature.bytes.data(), image.data() + at, length);
+            }
+
+            if (SignatureScanner::Find(image, signature) != NaiveFind(image, signature)) {
+                ++mismatches;
+            }
+        }
+
+        CHECK(mismatches == 0);
+    }
+
+    void TestRipRelative() {
+        std::vector<uint8_t> image(0x2000, 0xCC);
+        const uint8_t instruction[] = {0x48, 0x8B, 0x05, 0, 0, 0, 0, 0x48, 0x85, 0xC0};
+        std::memcpy(image.data() + 0x1000, instruction, sizeof(instruction));
+        int32_t displacement = -0x800;
+        std::memcpy(image.data() + 0x1003, &displacement, sizeof(displacement));
+
+        RipRelativeSignature target{"48 8B 05 ?? ?? ?? ?? 48 85 C0", 3, 7};
+        auto rva = SignatureScanner::ResolveRipRelative(image, target);
+        CHECK(rva && *rva == 0x1007 - 0x800);
+
+        // The displacement would run past the image.
+        RipRelativeSignature truncated{"48 85 C0", 8, 7};
+        CHECK(!SignatureScanner::ResolveRipRelative(std::span(image).first(0x100A), truncated));
+        CHECK(!SignatureScanner::ResolveRipRelative(image, {"48 8B 05 ?? 11 22", 3, 7}));
+    }
+
+    // A minimal header: MZ, e_lfanew at 0x3C, then "PE\0\0", machine, section count and the stamp.
+    std::vector<uint8_t> MakePeHeader(uint32_t peOffset, uint32_t timestamp) {
+        std::vector<uint8_t> header(0x1000);
+        header[0] = 'M';
+        header[1] = 'Z';
+        std::memcpy(header.data() + 0x3C, &peOffset, sizeof(peOffset));
+        if (peOffset + 12 <= header.size()) {
+            const uint8_t signature[] = {'P', 'E', 0, 0, 0x64, 0x86, 0x07, 0x00};
+            std::memcpy(header.data() + peOffset, signature, sizeof(signature));
+            std::memcpy(header.data() + peOffset + 8, &timestamp, sizeof(timestamp));
+        }
+        return header;
+    }
+
+    void TestPeTimestamp() {
+        auto header = MakePeHeader(0x108, 0x5C2DE3A1);
+        CHECK(SignatureScanner::ReadPeTimestamp(header) == 0x5C2DE3A1u);
+
+        // The stamp ending on the last byte of the header is still read.
+        auto atEnd = MakePeHeader(0x1000 - 12, 0x12345678);
+        CHECK(SignatureScanner::ReadPeTimestamp(atEnd) == 0x12345678u);
+        CHECK(!SignatureScanner::ReadPeTimestamp(std::span(atEnd).first(0x1000 - 1)));
+
+        auto noMz = header;
+        noMz[0] = 'X';
+        CHECK(!SignatureScanner::ReadPeTimestamp(noMz));
+
+        auto noPe = header;
+        noPe[0x109] = 'X';
+        CHECK(!SignatureScanner::ReadPeTimestamp(noPe));
+
+        CHECK(!SignatureScanner::ReadPeTimestamp(MakePeHeader(0x1000 - 11, 1)));
+        CHECK(!SignatureScanner::ReadPeTimestamp(MakePeHeader(0xFFFFFFF0, 1)));
+        CHECK(!SignatureScanner::ReadPeTimestamp(std::span(header).first(0x3F)));
+        CHECK(!SignatureScanner::ReadPeTimestamp({}));
+    }
+}
+
+int main() {
+    TestParse();
+    TestAgainstNaive();
+    TestRipRelative();
+    TestPeTimestamp();
+    return TestResult("SignatureScannerTest");
+}
@@ -0,0 +1,126 @@
+// 10,000 periodic timers, periods from 5 ms to 15 s, over 60 s of simulated time; each
+// dispatch re-arms its timer, as a SamplerPool job does. TimerWheel against the linear scan
+// for the earliest deadline SamplerPool used before, and a binary heap.
+
+#include "Check.h"
+
+#include "core/TimerWheel.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono;
+using Clock = TimerWheel::Clock;
+
+namespace {
+    constexpr size_t TIMERS = 10'000;
+    constexpr auto SIMULATED = seconds(60);
+
+    struct Result {
+        uint64_t dispatches = 0;
+        double ms = 0;
+    };
+
+    template<typename Run>
+    Result Measure(Run run) {
+        Result result;
+        auto start = steady_clock::now();
+        result.dispatches = run();
+        result.ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        return result;
+    }
+
+    void Print(const char* name, const Result& result) {
+        std::printf("%-6s %9llu dispatches %9.1f ms %7.0f ns/dispatch\n", name,
+            static_cast<unsigned long long>(result.dispatches), result.ms, result.ms * 1e6 / static_cast<double>(result.dispatches));
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::vector<milliseconds> periods(TIMERS);
+    std::vector<milliseconds> phases(TIMERS);
+    for (size_t i = 0; i < TIMERS; ++i) {
+        periods[i] = milliseconds(5 + rng() % 15'000);
+        phases[i] = milliseconds(rng() % periods[i].count());
+    }
+
+    const Clock::time_point origin = Clock::now();
+    const Clock::time_point end = origin + SIMULATED;
+
+    Result wheel = Measure([&] {
+        TimerWheel timers(origin);
+        for (size_t i = 0; i < TIMERS; ++i) {
+            timers.Schedule(i, origin + phases[i]);
+        }
+
+        uint64_t dispatches = 0;
+        std::vector<size_t> expired;
+        while (auto wakeup = timers.NextWakeup()) {
+            if (*wakeup > end) {
+                break;
+            }
+            expired.clear();
+            timers.Advance(*wakeup, expired);
+            for (size_t id : expired) {
+                ++dispatches;
+                timers.Schedule(id, *wakeup + periods[id]);
+            }
+        }
+        return dispatches;
+    });
+
+    Result scan = Measure([&] {
+        std::vector<Clock::time_point> due(TIMERS);
+        for (size_t i = 0; i < TIMERS; ++i) {
+            due[i] = origin + phases[i];
+        }
+
+        uint64_t dispatches = 0;
+        for (;;) {
+            size_t earliest = 0;
+            for (size_t i = 1; i < TIMERS; ++i) {
+                if (due[i] < due[earliest]) {
+                    earliest = i;
+                }
+            }
+            if (due[earliest] > end) {
+                break;
+            }
+            ++dispatches;
+            due[earliest] += periods[earliest];
+        }
+        return dispatches;
+    });
+
+    Result heap = Measure([&] {
+        using Entry = std::pair<Clock::time_point, size_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        for (size_t i = 0; i < TIMERS; ++i) {
+            queue.push({origin + phases[i], i});
+        }
+
+        uint64_t dispatches = 0;
+        while (queue.top().first <= end) {
+            auto [due, id] = queue.top();
+            queue.pop();
+            ++dispatches;
+            queue.push({due + periods[id], id});
+        }
+        return dispatches;
+    });
+
+    Print("wheel", wheel);
+    Print("scan", scan);
+    Print("heap", heap);
+
+    // The wheel dispatches on whole ticks and re-arms from the tick, so it can fall a few
+    // periods behind the exact schedules over a minute, never ahead.
+    CHECK(wheel.dispatches <= scan.dispatches && scan.dispatches == heap.dispatches);
+    CHECK(wheel.dispatches * 100 >= scan.dispatches * 99);
+    return TestResult("TimerWheelBench");
+}
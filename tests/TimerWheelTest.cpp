@@ -0,0 +1,142 @@
+// TimerWheel against a brute-force model that keeps every deadline in a flat array: random
+// arming, moving, cancelling and advancing over horizons from a few ticks to past the top
+// level. After every Advance the wheel must have handed out exactly the due timers, none
+// early, earliest first, and NextWakeup must not be later than the earliest deadline.
+
+#include "Check.h"
+
+#include "core/TimerWheel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using Clock = TimerWheel::Clock;
+
+namespace {
+    constexpr int64_t NOT_ARMED = -1;
+
+    // A deadline fires on the first whole tick at or after it.
+    int64_t DueTick(Clock::time_point due, Clock::time_point origin) {
+        return std::max<int64_t>(0, ceil<milliseconds>(due - origin).count());
+    }
+
+    void TestAgainstModel(uint64_t seed) {
+        constexpr size_t TIMERS = 2000;
+        const int64_t horizonsMs[] = {5, 300, 20'000, 2'000'000, 20'000'000'000};
+        const int64_t stepsMs[] = {1, 7, 500, 100'000, 30'000'000};
+
+        std::mt19937_64 rng(seed);
+        Clock::time_point origin = Clock::time_point{} + hours(1);
+        TimerWheel wheel(origin);
+        std::vector<int64_t> dueTicks(TIMERS, NOT_ARMED);
+        Clock::time_point now = origin;
+        int64_t advancedTo = 0;
+        std::vector<size_t> expired;
+        int early = 0, missed = 0, misordered = 0, wakeupLate = 0, stateMismatch = 0;
+
+        for (int step = 0; step < 20'000; ++step) {
+            size_t id = rng() % TIMERS;
+            int op = static_cast<int>(rng() % 10);
+
+            if (op < 5) {
+                // Some deadlines are already a little in the past.
+                int64_t horizon = horizonsMs[rng() % std::size(horizonsMs)];
+                auto due = now + microseconds(rng() % (horizon * 1000)) - microseconds(rng() % 3 == 0 ? 2000 : 0);
+                wheel.Schedule(id, due);
+                dueTicks[id] = DueTick(due, origin);
+            } else if (op < 6) {
+                wheel.Cancel(id);
+                dueTicks[id] = NOT_ARMED;
+            } else if (op < 7) {
+                wheel.Schedule(id, Clock::time_point::max());
+                dueTicks[id] = NOT_ARMED;
+            } else {
+                auto wakeup = wheel.NextWakeup();
+                if (rng() % 3 == 0 && wakeup && *wakeup > now) {
+                    now = *wakeup;
+                } else {
+                    now += microseconds(rng() % (stepsMs[rng() % std::size(stepsMs)] * 1000));
+                }
+                int64_t nowTick = floor<milliseconds>(now - origin).count();
+
+                expired.clear();
+                wheel.Advance(now, expired);
+
+                // Timers armed with a deadline the wheel had already passed come first, in
+                // no particular order; the rest follow in deadline order.
+                int64_t previousDue = advancedTo;
+                for (size_t fired : expired) {
+                    if (dueTicks[fired] == NOT_ARMED || dueTicks[fired] > nowTick) {
+                        ++early;
+                    } else if (dueTicks[fired] <= advancedTo) {
+                        if (previousDue > advancedTo) {
+                            ++misordered;
+                        }
+                    } else if (dueTicks[fired] < previousDue) {
+                        ++misordered;
+                    } else {
+                        previousDue = dueTicks[fired];
+                    }
+                    dueTicks[fired] = NOT_ARMED;
+                }
+                advancedTo = std::max(advancedTo, nowTick);
+
+                int64_t earliest = INT64_MAX;
+                for (size_t timer = 0; timer < TIMERS; ++timer) {
+                    if (dueTicks[timer] == NOT_ARMED) {
+                        continue;
+                    }
+                    if (dueTicks[timer] <= nowTick) {
+                        ++missed;
+                    }
+                    earliest = std::min(earliest, dueTicks[timer]);
+                }
+
+                wakeup = wheel.NextWakeup();
+                if (earliest == INT64_MAX ? wakeup.has_value()
+                        : !wakeup || floor<milliseconds>(*wakeup - origin).count() > earliest) {
+                    ++wakeupLate;
+                }
+            }
+
+            if (wheel.IsScheduled(id) != (dueTicks[id] != NOT_ARMED)) {
+                ++stateMismatch;
+            }
+        }
+
+        CHECK(early == 0);
+        CHECK(missed == 0);
+        CHECK(misordered == 0);
+        CHECK(wakeupLate == 0);
+        CHECK(stateMismatch == 0);
+    }
+
+    // A deadline already passed fires on the next Advance, and a timer never fires twice.
+    void TestPastDeadline() {
+        Clock::time_point origin = Clock::time_point{} + hours(1);
+        TimerWheel wheel(origin);
+        std::vector<size_t> expired;
+
+        wheel.Advance(origin + milliseconds(100), expired);
+        wheel.Schedule(3, origin + milliseconds(10));
+        CHECK(wheel.NextWakeup().has_value());
+        wheel.Advance(origin + milliseconds(100), expired);
+        CHECK(expired == std::vector<size_t>{3});
+
+        expired.clear();
+        wheel.Advance(origin + seconds(10), expired);
+        CHECK(expired.empty());
+        CHECK(!wheel.NextWakeup().has_value());
+    }
+}
+
+int main() {
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+        TestAgainstModel(seed);
+    }
+    TestPastDeadline();
+    return TestResult("TimerWheelTest");
+}
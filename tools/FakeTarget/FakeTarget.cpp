@@ -0,0 +1,733 @@
+// Stand-in for DarkSoulsIII.exe, for load-testing and profiling Ember without the game.
+//
+// The process names itself DarkSoulsIII.exe, maps a module image under that name, and lays
+// out GameDataMan (with the inventory and equip slots), WorldChrMan (with a character list
+// holding the player, filler enemies and a boss) and the EventFlagMan flag region the way
+// DS3Fields.h reads them, including the code bytes the root signatures match. A script then
+// mutates deaths, HP, boss HP, zone, boss flag, event flags, souls, estus, the equipped weapon
+// and character data over time, while the player walks in a circle. Scripts are
+// plain text, so a run is replayed exactly with --script:
+//
+//   # <ms> <set|add> <field> <value>
+//   0 set name Ashen One
+//   1500 set hp 0
+//   1600 add deaths 1
+//   9000 set flag 2800
+//
+// Fields: deaths, hp, bosshp, region, zone, boss, level, class, name, souls, estus, weapon,
+// loading. Playtime advances on its own; "set loading 1" nulls WorldChrMan like a load screen.
+// "set flag <id>" and "set unflag <id>" set and clear bit <id> of the event flag region.
+// Without --script a script is generated from --seed; --dump-script prints it instead. The
+// process exits, like the game closing, once the script ends unless --loop is given.
+
+#include "memory/DS3Fields.h"
+#include "memory/GameBuilds.h"
+#include "memory/InventoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr const char* PROCESS_NAME = "DarkSoulsIII.exe";
+
+    // The fallback build's roots; the signatures below point at them too.
+    constexpr uintptr_t GAMEDATAMAN_RVA = GameBuilds::FALLBACK.gameDataMan;
+    constexpr uintptr_t WORLDCHRMAN_RVA = GameBuilds::FALLBACK.worldChrMan;
+    constexpr uintptr_t EVENTFLAGMAN_RVA = GameBuilds::FALLBACK.eventFlagMan;
+
+    // PE timestamp of the fake image on Linux; no real build has it, so Ember signature-scans.
+    constexpr uint32_t FAKE_BUILD_TIMESTAMP = 0x46414B45;
+    constexpr size_t IMAGE_SIZE = 0x04800000;
+
+    constexpr size_t BLOCK_SIZE = 0x2000;
+    constexpr auto TICK_INTERVAL = std::chrono::milliseconds(16);
+
+    constexpr uint32_t FULL_HP = 600;
+    constexpr int32_t BOSS_MAX_HP = 4000;
+
+    // Loaded enemies other than the boss, with small max HPs, so finding the boss takes a few passes.
+    constexpr size_t FILLER_CHARACTERS = 200;
+    constexpr uint32_t STARTING_PLAYTIME_MS = 3600 * 1000;
+
+    constexpr uint32_t EXPLORE_REGIONS[] = {300001, 300004, 310003, 301000, 300020};
+    constexpr uint32_t BOSS_REGIONS[] = {300007, 300006, 301010, 300023};
+
+    // Region bit indexes the generator flips when a boss dies, one per entry of BOSS_REGIONS.
+    constexpr uint32_t BOSS_KILL_FLAGS[] = {2800, 2890, 3800, 2830};
+
+    // Goods ids of the Estus Flask and Ashen Estus Flask, and two weapons to swap between.
+    constexpr uint32_t ESTUS_FLASK_ID = 0x400000C8;
+    constexpr uint32_t ASHEN_ESTUS_FLASK_ID = 0x400000F0;
+    constexpr uint32_t WEAPON_IDS[] = {0x000F4240, 0x001E8480};
+    constexpr uint32_t ESTUS_CHARGES = 5;
+    constexpr uint32_t ASHEN_ESTUS_CHARGES = 3;
+
+    // Inventory slots the fake holds items in; every other slot is empty.
+    constexpr size_t ESTUS_SLOT = 0;
+    constexpr size_t ASHEN_ESTUS_SLOT = 1;
+    constexpr size_t FIRST_WEAPON_SLOT = 2;
+
+    std::atomic<bool> g_stopRequested = false;
+
+    struct ScriptEvent {
+        uint64_t atMs;
+        std::string op;
+        std::string field;
+        std::string value;
+    };
+
+    struct Options {
+        uint32_t seed = 1;
+        uint64_t durationMs = 10 * 60 * 1000;
+        double speed = 1.0;
+        bool loop = false;
+        bool quiet = false;
+        bool dumpScript = false;
+        std::string scriptPath;
+    };
+
+    // The module the reader finds by name: a file-backed mapping on Linux so /proc/<pid>/maps
+    // shows it as DarkSoulsIII.exe, and a large zeroed array inside our own image on Windows.
+    struct ModuleImage {
+        uint8_t* base = nullptr;
+        uint8_t* writableBegin = nullptr;
+        uint8_t* writableEnd = nullptr;
+#ifndef _WIN32
+        std::string backingDir;
+        std::string backingPath;
+#endif
+
+        template<typename T>
+        bool Write(uintptr_t rva, const T& value) {
+            uint8_t* target = base + rva;
+            if (target < writableBegin || target + sizeof(T) > writableEnd) {
+                return false;
+            }
+            std::memcpy(target, &value, sizeof(T));
+            return true;
+        }
+
+        uintptr_t FirstWritableRva() const {
+            return std::max<uintptr_t>(0x1000, static_cast<uintptr_t>(writableBegin - base));
+        }
+    };
+
+#ifdef _WIN32
+    alignas(4096) uint8_t g_moduleImage[IMAGE_SIZE];
+
+    bool MapModule(ModuleImage& module) {
+        module.base = reinterpret_cast<uint8_t*>(GetModuleHandleW(nullptr));
+        module.writableBegin = g_moduleImage;
+        module.writableEnd = g_moduleImage + IMAGE_SIZE;
+        return true;
+    }
+
+    void UnmapModule(ModuleImage&) {}
+#else
+    bool MapModule(ModuleImage& module) {
+        const char* tempDir = std::getenv("TMPDIR");
+        module.backingDir = std::string(tempDir ? tempDir : "/tmp") + "/ember-fake-" + std::to_string(getpid());
+        module.backingPath = module.backingDir + "/" + PROCESS_NAME;
+
+        if (mkdir(module.backingDir.c_str(), 0700) != 0) {
+            return false;
+        }
+
+        int fd = open(module.backingPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0) {
+            return false;
+        }
+
+        // Sparse, and private pages are never written back, so the file stays empty on disk.
+        void* mapping = MAP_FAILED;
+        if (ftruncate(fd, IMAGE_SIZE) == 0) {
+            mapping = mmap(nullptr, IMAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+
+        module.base = static_cast<uint8_t*>(mapping);
+        module.writableBegin = module.base;
+        module.writableEnd = module.base + IMAGE_SIZE;
+
+        // Just enough of a PE header for the build check: e_lfanew, then the file header.
+        constexpr uint32_t PE_OFFSET = 0x80;
+        constexpr uint16_t MACHINE_AMD64 = 0x8664;
+        module.base[0] = 'M';
+        module.base[1] = 'Z';
+        std::memcpy(module.base + 0x3C, &PE_OFFSET, sizeof(PE_OFFSET));
+        std::memcpy(module.base + PE_OFFSET, "PE\0\0", 4);
+        std::memcpy(module.base + PE_OFFSET + 4, &MACHINE_AMD64, sizeof(MACHINE_AMD64));
+        std::memcpy(module.base + PE_OFFSET + 8, &FAKE_BUILD_TIMESTAMP, sizeof(FAKE_BUILD_TIMESTAMP));
+        return true;
+    }
+
+    void UnmapModule(ModuleImage& module) {
+        if (module.base) {
+            munmap(module.base, IMAGE_SIZE);
+        }
+        unlink(module.backingPath.c_str());
+        rmdir(module.backingDir.c_str());
+    }
+#endif
+
+    // "mov rax, [rip+disp32]; test rax, rax; jz; mov rax, [rax+8]; ret" and the WorldChrMan
+    // and EventFlagMan equivalents, encoded so their displacements land on the root pointers.
+    bool WriteRootSignatures(ModuleImage& module) {
+        const uint8_t gameDataManCode[] = {
+            0x48, 0x8B, 0x05, 0, 0, 0, 0, 0x48, 0x85, 0xC0, 0x74, 0x05, 0x48, 0x8B, 0x40, 0x08, 0xC3
+        };
+        const uint8_t worldChrManCode[] = {
+            0x48, 0x8B, 0x1D, 0, 0, 0, 0, 0x48, 0x8B, 0xF9, 0x48, 0x85, 0xDB, 0x74, 0x10, 0x8B, 0x11, 0x85,
+            0xD2, 0x74, 0x08, 0x8D
+        };
+        const uint8_t eventFlagManCode[] = {
+            0x48, 0xC7, 0x05, 0, 0, 0, 0, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8B, 0x7C, 0x24, 0x38, 0xC7, 0x46,
+            0x54, 0xFF, 0xFF, 0xFF, 0xFF, 0x48, 0x83, 0xC4, 0x20, 0x5E, 0xC3
+        };
+
+        auto place = [&](uintptr_t rva, std::span<const uint8_t> code, uintptr_t target, size_t instructionLength) {
+            for (size_t i = 0; i < code.size(); ++i) {
+                if (!module.Write(rva + i, code[i])) {
+                    return false;
+                }
+            }
+            int32_t displacement = static_cast<int32_t>(target - (rva + instructionLength));
+            return module.Write(rva + 3, displacement);
+        };
+
+        uintptr_t codeRva = module.FirstWritableRva();
+        return place(codeRva, gameDataManCode, GAMEDATAMAN_RVA, 7)
+            && place(codeRva + 0x100, worldChrManCode, WORLDCHRMAN_RVA, 7)
+            && place(codeRva + 0x200, eventFlagManCode, EVENTFLAGMAN_RVA, 11);
+    }
+
+    // Heap blocks behind the root pointers. Intermediate pointers along a path are created
+    // the first time a field on it is written.
+    class FakeHeap {
+    private:
+        std::vector<std::unique_ptr<uint8_t[]>> blocks;
+        uint8_t* roots[PATH_ROOT_COUNT] = {};
+        std::unique_ptr<uint8_t[]> flagRegion;
+        std::unique_ptr<InventorySlot[]> inventory;
+
+        uint8_t* Allocate() {
+            blocks.push_back(std::make_unique<uint8_t[]>(BLOCK_SIZE));
+            return blocks.back().get();
+        }
+
+        std::unique_ptr<uint8_t*[]> characterList;
+        size_t characterCount = 0;
+        uint8_t* bossCharacter = nullptr;
+
+        uint8_t* ResolveFrom(uint8_t* block, std::span<const uintptr_t> offsets) {
+            for (uintptr_t offset : offsets) {
+                uint8_t* next = nullptr;
+                std::memcpy(&next, block + offset, sizeof(next));
+                if (!next) {
+                    next = Allocate();
+                    std::memcpy(block + offset, &next, sizeof(next));
+                }
+                block = next;
+            }
+            return block;
+        }
+
+        template<typename Path>
+        uint8_t* Resolve() {
+            return ResolveFrom(roots[static_cast<size_t>(Path::root)], Path::offsets);
+        }
+
+        void SetCharacterHP(uint8_t* character, int32_t hp, int32_t maxHP) {
+            uint8_t* hpBlock = ResolveFrom(character, DS3Fields::CHARACTER_HP_CHAIN);
+            std::memcpy(hpBlock + DS3Fields::CHARACTER_HP_OFFSET, &hp, sizeof(hp));
+            std::memcpy(hpBlock + DS3Fields::CHARACTER_MAX_HP_OFFSET, &maxHP, sizeof(maxHP));
+        }
+
+        // The player first, then the filler enemies with the boss in the middle, as a
+        // [begin, end) pointer array.
+        void AttachCharacters() {
+            characterCount = FILLER_CHARACTERS + 2;
+            characterList = std::make_unique<uint8_t*[]>(characterCount);
+            characterList[0] = Resolve<DS3Fields::Player>();
+
+            for (size_t i = 1; i < characterCount; ++i) {
+                characterList[i] = Allocate();
+                int32_t maxHP = static_cast<int32_t>(150 + (i * 37) % 700);
+                SetCharacterHP(characterList[i], maxHP, maxHP);
+            }
+
+            bossCharacter = characterList[characterCount / 2];
+
+            uint64_t begin = reinterpret_cast<uintptr_t>(characterList.get());
+            Set<DS3Fields::CharacterListBegin>(begin);
+            Set<DS3Fields::CharacterListEnd>(begin + characterCount * sizeof(uint8_t*));
+        }
+
+    public:
+        bool Attach(ModuleImage& module) {
+            roots[static_cast<size_t>(PathRoot::GameDataMan)] = Allocate();
+            roots[static_cast<size_t>(PathRoot::WorldChrMan)] = Allocate();
+            roots[static_cast<size_t>(PathRoot::EventFlagMan)] = Allocate();
+
+            // The flag region is far larger than a heap block, so it gets its own allocation.
+            flagRegion = std::make_unique<uint8_t[]>(DS3Fields::EVENT_FLAG_REGION_SIZE);
+            uint8_t* region = flagRegion.get();
+            std::memcpy(roots[static_cast<size_t>(PathRoot::EventFlagMan)] + DS3Fields::EventFlags::offsets[0],
+                &region, sizeof(region));
+
+            // The item slots outgrow a heap block too.
+            inventory = std::make_unique<InventorySlot[]>(DS3Fields::INVENTORY_SLOT_COUNT);
+            for (size_t slot = 0; slot < DS3Fields::INVENTORY_SLOT_COUNT; ++slot) {
+                inventory[slot] = {0, DS3Fields::EMPTY_ITEM_ID, 0, 0};
+            }
+            using InventoryData = PointerPath<PathRoot::GameDataMan, 0x10, 0x470>;
+            InventorySlot* slots = inventory.get();
+            std::memcpy(Resolve<InventoryData>() + DS3Fields::InventoryItems::offsets[2], &slots, sizeof(slots));
+
+            AttachCharacters();
+
+            return module.Write(GAMEDATAMAN_RVA, roots[static_cast<size_t>(PathRoot::GameDataMan)])
+                && module.Write(WORLDCHRMAN_RVA, roots[static_cast<size_t>(PathRoot::WorldChrMan)])
+                && module.Write(EVENTFLAGMAN_RVA, roots[static_cast<size_t>(PathRoot::EventFlagMan)]);
+        }
+
+        // Flags are packed into 32-bit words, highest bit first, like the game stores them.
+        void SetFlag(uint32_t flag, bool set) {
+            uint8_t* word = flagRegion.get() + (flag / 32) * sizeof(uint32_t);
+            uint32_t bits;
+            std::memcpy(&bits, word, sizeof(bits));
+            uint32_t bit = 0x80000000u >> (flag % 32);
+            bits = set ? bits | bit : bits & ~bit;
+            std::memcpy(word, &bits, sizeof(bits));
+        }
+
+        template<typename Field>
+        void Set(typename Field::Value value) {
+            static_assert(Field::offset + sizeof(value) <= BLOCK_SIZE);
+            std::memcpy(Resolve<typename Field::Chain>() + Field::offset, &value, sizeof(value));
+        }
+
+        // Load screens tear the world down, which leaves the WorldChrMan root null.
+        bool SetLoading(ModuleImage& module, bool loading) {
+            uint8_t* worldChrMan = loading ? nullptr : roots[static_cast<size_t>(PathRoot::WorldChrMan)];
+            return module.Write(WORLDCHRMAN_RVA, worldChrMan);
+        }
+
+        void SetInventorySlot(size_t slot, uint32_t itemId, uint32_t quantity) {
+            inventory[slot] = {static_cast<uint32_t>(slot), itemId, quantity, 0};
+        }
+
+        void SetEquippedItems(const uint32_t (&items)[DS3Fields::EQUIP_SLOT_COUNT]) {
+            std::memcpy(Resolve<DS3Fields::CharacterData>() + DS3Fields::EquippedItems::offset, items, sizeof(items));
+        }
+
+        void SetBossHP(int32_t hp) {
+            SetCharacterHP(bossCharacter, hp, BOSS_MAX_HP);
+        }
+
+        void SetName(const std::string& name) {
+            char16_t wide[DS3Fields::CHARACTER_NAME_LENGTH] = {};
+            for (size_t i = 0; i < name.size() && i + 1 < DS3Fields::CHARACTER_NAME_LENGTH; ++i) {
+                wide[i] = static_cast<char16_t>(static_cast<unsigned char>(name[i]));
+            }
+            std::memcpy(Resolve<DS3Fields::CharacterData>() + DS3Fields::CharacterName::offset, wide, sizeof(wide));
+        }
+    };
+
+    struct GameState {
+        uint32_t deaths = 0;
+        int32_t hp = FULL_HP;
+        int32_t bossHP = BOSS_MAX_HP;
+        uint32_t region = EXPLORE_REGIONS[0];
+        uint32_t zone = EXPLORE_REGIONS[0];
+        uint32_t boss = 0;
+        uint32_t level = 20;
+        uint8_t characterClass = 1;
+        std::string name = "Ashen One";
+        uint32_t playtime = STARTING_PLAYTIME_MS;
+        uint32_t souls = 0;
+        uint32_t estus = ESTUS_CHARGES;
+        uint32_t weapon = 0;
+        uint32_t loading = 0;
+        std::map<uint32_t, bool> flags;
+
+        void WriteTo(FakeHeap& heap) const {
+            heap.Set<DS3Fields::DeathCount>(deaths);
+            heap.Set<DS3Fields::PlayTime>(playtime);
+            heap.Set<DS3Fields::BossFight>(boss);
+            heap.Set<DS3Fields::PlayRegion>(region);
+            heap.Set<DS3Fields::Zone>(zone);
+            heap.Set<DS3Fields::PlayerHP>(hp);
+
+            // Walks a 20 m circle once a minute, standing still while dead.
+            if (hp > 0) {
+                double angle = (playtime % 60000) / 60000.0 * 2 * 3.14159265358979;
+                heap.Set<DS3Fields::PositionX>(static_cast<float>(100 + 20 * std::cos(angle)));
+                heap.Set<DS3Fields::PositionY>(-12.5f);
+                heap.Set<DS3Fields::PositionZ>(static_cast<float>(-40 + 20 * std::sin(angle)));
+            }
+            heap.Set<DS3Fields::Level>(level);
+            heap.Set<DS3Fields::Souls>(souls);
+
+            // Estus, the ashen flask and both weapons are held; the weapon in use is in right hand 1.
+            heap.SetInventorySlot(ESTUS_SLOT, ESTUS_FLASK_ID, estus);
+            heap.SetInventorySlot(ASHEN_ESTUS_SLOT, ASHEN_ESTUS_FLASK_ID, ASHEN_ESTUS_CHARGES);
+            for (size_t i = 0; i < std::size(WEAPON_IDS); ++i) {
+                heap.SetInventorySlot(FIRST_WEAPON_SLOT + i, WEAPON_IDS[i], 1);
+            }
+
+            uint32_t equipped[DS3Fields::EQUIP_SLOT_COUNT];
+            std::fill(std::begin(equipped), std::end(equipped), DS3Fields::EMPTY_ITEM_ID);
+            equipped[3] = WEAPON_IDS[weapon % std::size(WEAPON_IDS)];
+            heap.SetEquippedItems(equipped);
+            heap.Set<DS3Fields::CharacterClass>(characterClass);
+            heap.SetName(name);
+            heap.SetBossHP(bossHP);
+
+            for (const auto& [flag, set] : flags) {
+                heap.SetFlag(flag, set);
+            }
+
+            heap.Set<DS3Fields::Vigor>(15);
+            heap.Set<DS3Fields::Attunement>(10);
+            heap.Set<DS3Fields::Endurance>(15);
+            heap.Set<DS3Fields::Vitality>(15);
+            heap.Set<DS3Fields::Strength>(18);
+            heap.Set<DS3Fields::Dexterity>(12);
+            heap.Set<DS3Fields::Intelligence>(8);
+            heap.Set<DS3Fields::Faith>(9);
+            heap.Set<DS3Fields::Luck>(7);
+        }
+
+        bool Apply(const ScriptEvent& event) {
+            if (event.field == "name") {
+                name = event.value;
+                return event.op == "set";
+            }
+
+            int64_t value = 0;
+            try {
+                value = std::stoll(event.value, nullptr, 0);
+            }
+            catch (...) {
+                return false;
+            }
+
+            auto update = [&](auto& target) {
+                using Target = std::remove_reference_t<decltype(target)>;
+                target = static_cast<Target>(event.op == "add" ? static_cast<int64_t>(target) + value : value);
+            };
+
+            if (event.op != "set" && event.op != "add") return false;
+
+            if (event.field == "flag" || event.field == "unflag") {
+                if (event.op != "set" || value < 0 || value >= static_cast<int64_t>(DS3Fields::EVENT_FLAG_REGION_SIZE * 8)) {
+                    return false;
+                }
+                flags[static_cast<uint32_t>(value)] = event.field == "flag";
+                return true;
+            }
+
+            if (event.field == "deaths") update(deaths);
+            else if (event.field == "hp") update(hp);
+            else if (event.field == "bosshp") update(bossHP);
+            else if (event.field == "region") update(region);
+            else if (event.field == "zone") update(zone);
+            else if (event.field == "boss") update(boss);
+            else if (event.field == "level") update(level);
+            else if (event.field == "class") update(characterClass);
+            else if (event.field == "souls") update(souls);
+            else if (event.field == "estus") update(estus);
+            else if (event.field == "weapon") update(weapon);
+            else if (event.field == "loading") update(loading);
+            else return false;
+
+            return true;
+        }
+    };
+
+    // Uses only raw mt19937 output, which the standard pins down exactly, so the same seed
+    // gives the same script with every compiler (the std distributions do not).
+    class ScriptGenerator {
+    private:
+        std::mt19937 rng;
+        std::vector<ScriptEvent> events;
+        uint32_t estusLeft = ESTUS_CHARGES;
+
+        uint32_t Next(uint32_t bound) {
+            return static_cast<uint32_t>(rng() % bound);
+        }
+
+        void Emit(uint64_t atMs, const char* op, const char* field, int64_t value) {
+            events.push_back({atMs, op, field, std::to_string(value)});
+        }
+
+        uint64_t Die(uint64_t t) {
+            Emit(t, "set", "hp", 0);
+            Emit(t, "set", "souls", 0);
+            Emit(t + 100, "add", "deaths", 1);
+            Emit(t + 2500, "set", "loading", 1);
+            Emit(t + 3900, "set", "loading", 0);
+            Emit(t + 4000, "set", "hp", FULL_HP);
+            Emit(t + 4000, "set", "estus", ESTUS_CHARGES);
+            estusLeft = ESTUS_CHARGES;
+            return t + 4000;
+        }
+
+    public:
+        explicit ScriptGenerator(uint32_t seed) : rng(seed) {}
+
+        std::vector<ScriptEvent> Generate(uint64_t durationMs) {
+            events.clear();
+            estusLeft = ESTUS_CHARGES;
+            events.push_back({0, "set", "name", "Ashen One"});
+            Emit(0, "set", "class", 1);
+            Emit(0, "set", "level", 20);
+            Emit(0, "set", "hp", FULL_HP);
+            Emit(0, "set", "region", EXPLORE_REGIONS[0]);
+
+            uint64_t t = 1000;
+            while (t < durationMs) {
+                uint32_t kind = Next(10);
+
+                if (kind < 5) {
+                    // A fight with a regular enemy: hurt, a sip of estus, souls for the kill.
+                    Emit(t, "set", "hp", FULL_HP - 50 - Next(350));
+                    if (estusLeft > 0) {
+                        Emit(t + 2000, "add", "estus", -1);
+                        --estusLeft;
+                    }
+                    Emit(t + 2000, "set", "hp", FULL_HP);
+                    Emit(t + 2000, "add", "souls", 50 + Next(400));
+                    t += 2000;
+                } else if (kind < 7) {
+                    uint32_t region = EXPLORE_REGIONS[Next(std::size(EXPLORE_REGIONS))];
+                    Emit(t, "set", "region", region);
+                    Emit(t, "set", "zone", region);
+                } else if (kind == 7) {
+                    t = Die(t);
+                } else if (kind == 8) {
+                    uint32_t boss = Next(std::size(BOSS_REGIONS));
+                    Emit(t, "set", "region", BOSS_REGIONS[boss]);
+                    Emit(t, "set", "boss", 1);
+                    Emit(t, "set", "bosshp", BOSS_MAX_HP);
+
+                    uint32_t hits = 2 + Next(4);
+                    for (uint32_t hit = 0; hit < hits; ++hit) {
+                        t += 3000 + Next(5000);
+                        Emit(t, "set", "hp", FULL_HP - 100 - Next(400));
+                        Emit(t + 500, "add", "bosshp", -BOSS_MAX_HP / static_cast<int32_t>(hits + 1));
+                    }
+
+                    t += 2000;
+                    if (Next(10) < 3) {
+                        t = Die(t);
+                        Emit(t, "set", "region", EXPLORE_REGIONS[0]);
+                    } else {
+                        Emit(t, "set", "bosshp", 0);
+                        Emit(t, "set", "flag", BOSS_KILL_FLAGS[boss]);
+                        Emit(t, "add", "souls", 10000);
+                    }
+                    Emit(t, "set", "boss", 0);
+                    Emit(t, "set", "hp", FULL_HP);
+                } else if (Next(2) == 0) {
+                    Emit(t, "add", "level", 1);
+                    Emit(t, "set", "souls", 0);
+                } else {
+                    Emit(t, "add", "weapon", 1);
+                    Emit(t, "set", "estus", ESTUS_CHARGES);
+                    estusLeft = ESTUS_CHARGES;
+                }
+
+                t += 1000 + Next(7000);
+            }
+
+            std::stable_sort(events.begin(), events.end(),
+                [](const ScriptEvent& a, const ScriptEvent& b) { return a.atMs < b.atMs; });
+            return events;
+        }
+    };
+
+    bool LoadScript(const std::string& path, std::vector<ScriptEvent>& events) {
+        std::ifstream scriptFile(path);
+        if (!scriptFile) {
+            return false;
+        }
+
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(scriptFile, line)) {
+            ++lineNumber;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            ScriptEvent event{};
+            if (fields >> event.atMs >> event.op >> event.field) {
+                std::getline(fields >> std::ws, event.value);
+            }
+
+            if (event.value.empty()) {
+                std::fprintf(stderr, "%s:%zu: expected '<ms> <set|add> <field> <value>'\n", path.c_str(), lineNumber);
+                return false;
+            }
+            events.push_back(std::move(event));
+        }
+
+        std::stable_sort(events.begin(), events.end(),
+            [](const ScriptEvent& a, const ScriptEvent& b) { return a.atMs < b.atMs; });
+        return true;
+    }
+
+    void PrintEvent(FILE* out, const ScriptEvent& event) {
+        std::fprintf(out, "%llu %s %s %s\n", static_cast<unsigned long long>(event.atMs),
+            event.op.c_str(), event.field.c_str(), event.value.c_str());
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--seed" && hasValue) options.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--duration" && hasValue) options.durationMs = std::stoull(argv[++i]) * 1000;
+            else if (arg == "--speed" && hasValue) options.speed = std::max(0.01, std::stod(argv[++i]));
+            else if (arg == "--script" && hasValue) options.scriptPath = argv[++i];
+            else if (arg == "--loop") options.loop = true;
+            else if (arg == "--quiet") options.quiet = true;
+            else if (arg == "--dump-script") options.dumpScript = true;
+            else return false;
+        }
+        return true;
+    }
+
+#ifndef _WIN32
+    // Ember finds the game by argv[0], so re-exec under the game's name when started as FakeTarget.
+    void EnsureProcessName(char** argv) {
+        const char* name = std::strrchr(argv[0], '/');
+        name = name ? name + 1 : argv[0];
+        if (std::strcmp(name, PROCESS_NAME) == 0) {
+            return;
+        }
+
+        argv[0] = const_cast<char*>(PROCESS_NAME);
+        execv("/proc/self/exe", argv);
+        std::perror("execv");
+    }
+#endif
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+            "usage: FakeTarget [--seed N] [--duration SECONDS] [--script FILE] [--speed X] [--loop] [--quiet] [--dump-script]\n");
+        return 2;
+    }
+
+    std::vector<ScriptEvent> events;
+    if (!options.scriptPath.empty()) {
+        if (!LoadScript(options.scriptPath, events)) {
+            std::fprintf(stderr, "Cannot load script %s\n", options.scriptPath.c_str());
+            return 1;
+        }
+    } else {
+        events = ScriptGenerator(options.seed).Generate(options.durationMs);
+    }
+
+    if (options.dumpScript) {
+        std::printf("# FakeTarget script, seed %u\n", options.seed);
+        for (const ScriptEvent& event : events) {
+            PrintEvent(stdout, event);
+        }
+        return 0;
+    }
+
+#ifndef _WIN32
+    EnsureProcessName(argv);
+#endif
+
+    std::signal(SIGINT, [](int) { g_stopRequested = true; });
+    std::signal(SIGTERM, [](int) { g_stopRequested = true; });
+
+    ModuleImage module;
+    FakeHeap heap;
+    if (!MapModule(module) || !WriteRootSignatures(module) || !heap.Attach(module)) {
+        std::fprintf(stderr, "Cannot lay out the module image\n");
+        UnmapModule(module);
+        return 1;
+    }
+
+    GameState state;
+    state.WriteTo(heap);
+    heap.SetLoading(module, state.loading != 0);
+
+    uint64_t scriptEndMs = events.empty() ? 0 : events.back().atMs;
+    uint64_t loopOffsetMs = 0;
+    size_t nextEvent = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    while (!g_stopRequested) {
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        uint64_t scriptMs = static_cast<uint64_t>(elapsed.count() * options.speed);
+
+        while (nextEvent < events.size() && events[nextEvent].atMs + loopOffsetMs <= scriptMs) {
+            const ScriptEvent& event = events[nextEvent++];
+            if (!state.Apply(event)) {
+                std::fprintf(stderr, "Ignoring invalid event: ");
+                PrintEvent(stderr, event);
+            } else if (!options.quiet) {
+                std::printf("[%8llu ms] ", static_cast<unsigned long long>(event.atMs + loopOffsetMs));
+                PrintEvent(stdout, event);
+                std::fflush(stdout);
+            }
+        }
+
+        state.playtime = STARTING_PLAYTIME_MS + static_cast<uint32_t>(scriptMs);
+        state.WriteTo(heap);
+        heap.SetLoading(module, state.loading != 0);
+
+        if (nextEvent == events.size()) {
+            if (!options.loop) {
+                break;
+            }
+            loopOffsetMs += scriptEndMs + 1000;
+            nextEvent = 0;
+        }
+
+        std::this_thread::sleep_for(TICK_INTERVAL);
+    }
+
+    UnmapModule(module);
+    return 0;
+}